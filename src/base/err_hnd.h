@@ -32,6 +32,8 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <exception>
 
 #ifndef DOXYGEN_NO_O2NS
 namespace o2scl {
@@ -326,6 +328,70 @@ namespace o2scl {
   inline void error_update(int &ret, int err) { if (ret==0) ret=err; }
   //@}
 
+  /** \brief Store the exceptions thrown inside a parallel region
+      so that they can be rethrown afterwards
+
+      An exception cannot propagate out of an OpenMP parallel
+      region. Instead, the work for index \c i (a point or a chunk
+      of points) is performed inside \ref run(), which stores any
+      exception which is thrown. After the parallel region, \ref
+      rethrow() rethrows the stored exception with the smallest
+      index. Since the original exception object is rethrown, its
+      type (and thus the class of the error) is preserved. 
+
+      Different threads must use different indices.
+   */
+  class err_para_store {
+
+  protected:
+
+    /// The stored exceptions
+    std::vector<std::exception_ptr> eptrs;
+
+  public:
+
+    /// Create an object which stores \c n exceptions
+    err_para_store(size_t n=0) : eptrs(n) {
+    }
+
+    /// Clear the stored exceptions and set the number to \c n
+    void resize(size_t n) {
+      eptrs.clear();
+      eptrs.resize(n);
+      return;
+    }
+    
+    /** \brief Call \c f and store any exception thrown at index
+	\c i, returning true if an exception was thrown
+    */
+    template<class func_t> bool run(size_t i, func_t &&f) {
+      try {
+	f();
+      } catch (...) {
+	eptrs[i]=std::current_exception();
+	return true;
+      }
+      return false;
+    }
+
+    /// Return true if any exceptions were stored
+    bool any() const {
+      for(size_t i=0;i<eptrs.size();i++) {
+	if (eptrs[i]) return true;
+      }
+      return false;
+    }
+    
+    /// Rethrow the first stored exception, if there is one
+    void rethrow() const {
+      for(size_t i=0;i<eptrs.size();i++) {
+	if (eptrs[i]) std::rethrow_exception(eptrs[i]);
+      }
+      return;
+    }
+    
+  };
+
 #ifdef O2SCL_NEVER_DEFINED
   
   /** \brief A version of \c assert, i.e. exit if the error value is
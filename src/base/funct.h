@@ -47,6 +47,15 @@ namespace o2scl {
   /// One-dimensional function typedef in src/base/funct.h
   typedef std::function<long double(long double)> funct_ld;
 
+  /** \brief Vectorized one-dimensional function typedef in
+      src/base/funct.h
+
+      A function of this type should evaluate the function at the
+      \c n points stored in the first argument and store the results
+      in the second argument.
+  */
+  typedef std::function<void(size_t,const double *,double *)> funct_vec;
+
   /** \brief One-dimensional function from a string
       
       For example,
@@ -55,6 +55,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <cmath>
+#include <algorithm>
 
 #include <o2scl/shunting_yard.h>
 
@@ -109,6 +110,52 @@ std::map<std::string, int> calculator::buildOpPrecedence() {
 std::map<std::string, int> calculator::opPrecedence=
   calculator::buildOpPrecedence();
 
+std::map<std::string, calculator::bc_opcode> calculator::buildBcOps() {
+  std::map<std::string, bc_opcode> opb;
+  
+  // Map from the operator names in the RPN to opcodes
+  opb["sin"]=bc_sin;
+  opb["cos"]=bc_cos;
+  opb["tan"]=bc_tan;
+  opb["sqrt"]=bc_sqrt;
+  opb["log"]=bc_log;
+  opb["exp"]=bc_exp;
+  opb["abs"]=bc_abs;
+  opb["log10"]=bc_log10;
+  opb["asin"]=bc_asin;
+  opb["acos"]=bc_acos;
+  opb["atan"]=bc_atan;
+  opb["sinh"]=bc_sinh;
+  opb["cosh"]=bc_cosh;
+  opb["tanh"]=bc_tanh;
+  opb["asinh"]=bc_asinh;
+  opb["acosh"]=bc_acosh;
+  opb["atanh"]=bc_atanh;
+  opb["floor"]=bc_floor;
+  opb["+"]=bc_add;
+  opb["*"]=bc_mul;
+  opb["-"]=bc_sub;
+  opb["/"]=bc_div;
+  opb["<<"]=bc_lshift;
+  opb["^"]=bc_pow;
+  opb[">>"]=bc_rshift;
+  opb["%"]=bc_mod;
+  opb["<"]=bc_lt;
+  opb[">"]=bc_gt;
+  opb["<="]=bc_leq;
+  opb[">="]=bc_geq;
+  opb["=="]=bc_eq;
+  opb["!="]=bc_neq;
+  opb["&&"]=bc_and;
+  opb["||"]=bc_or;
+
+  return opb;
+}
+
+// Builds the bcOps map only once:
+std::map<std::string, calculator::bc_opcode> calculator::bcOps=
+  calculator::buildBcOps();
+
 bool calculator::isvariablechar(const char c) {
   return (isalpha(c) || c == '_');
 }
@@ -470,7 +517,7 @@ calculator::~calculator() {
 calculator::calculator(const char* expr,
 		       std::map<std::string, double>* vars,
 		       bool debug,
-		       std::map<std::string, int> opPrec) {
+		       std::map<std::string, int> opPrec) : bc_depth(0) {
   compile(expr,vars,debug,opPrec);
 }
 
@@ -483,6 +530,193 @@ void calculator::compile(const char* expr,
   cleanRPN(this->RPN);
 
   this->RPN = calculator::toRPN(expr,vars,debug,opPrec);
+
+  // Any previous bytecode is now out of date
+  bytecode.clear();
+  bc_slots.clear();
+  bc_depth=0;
+}
+
+void calculator::compile_bytecode(const std::vector<std::string> &names) {
+
+  // Map from variable names to slots
+  std::map<std::string,size_t> slot_map;
+  for(size_t i=0;i<names.size();i++) {
+    slot_map[names[i]]=i;
+  }
+
+  std::vector<bc_instr> bc;
+  std::vector<size_t> slots;
+  size_t depth=0, max_depth=0;
+  
+  TokenQueue_t rpn=this->RPN;
+  while (!rpn.empty()) {
+    TokenBase* base=rpn.front();
+    rpn.pop();
+
+    bc_instr ins;
+    ins.slot=0;
+    ins.val=0.0;
+    
+    if (base->type==OP) {
+      Token<std::string>* strTok=static_cast<Token<std::string>*>(base);
+      std::map<std::string,bc_opcode>::iterator it=bcOps.find(strTok->val);
+      if (it==bcOps.end()) {
+	throw std::domain_error("Unknown operator: '"+strTok->val+"'.");
+      }
+      ins.op=it->second;
+      // Binary operators consume one more stack entry than
+      // functions of one variable
+      size_t n_args=(ins.op>=bc_add) ? 2 : 1;
+      if (depth<n_args) {
+	throw std::domain_error("Invalid equation.");
+      }
+      depth-=n_args-1;
+    } else if (base->type==NUM) {
+      ins.op=bc_num;
+      ins.val=static_cast<Token<double>*>(base)->val;
+      depth++;
+    } else if (base->type==VAR) {
+      Token<std::string>* strTok=static_cast<Token<std::string>*>(base);
+      std::map<std::string,size_t>::iterator it=slot_map.find(strTok->val);
+      if (it==slot_map.end()) {
+	throw std::domain_error("Unable to find the variable '"+
+				strTok->val+"'.");
+      }
+      ins.op=bc_var;
+      ins.slot=it->second;
+      slots.push_back(it->second);
+      depth++;
+    } else {
+      throw std::domain_error("Invalid token.");
+    }
+    if (depth>max_depth) max_depth=depth;
+    bc.push_back(ins);
+  }
+
+  if (depth!=1) {
+    throw std::domain_error("Invalid equation.");
+  }
+
+  std::sort(slots.begin(),slots.end());
+  slots.erase(std::unique(slots.begin(),slots.end()),slots.end());
+
+  bytecode.swap(bc);
+  bc_slots.swap(slots);
+  bc_depth=max_depth;
+  
+  return;
+}
+
+double calculator::eval_bytecode(const double *vals) const {
+  
+  if (bytecode.size()==0) {
+    throw std::domain_error("Bytecode not compiled in eval_bytecode().");
+  }
+  
+  // Set up one pointer for each slot, each pointing to a single value
+  std::vector<const double *> cols(bc_slots.size()==0 ? 0 :
+				   bc_slots[bc_slots.size()-1]+1);
+  for(size_t k=0;k<bc_slots.size();k++) {
+    cols[bc_slots[k]]=vals+bc_slots[k];
+  }
+  double ret;
+  std::vector<double> work;
+  eval_bytecode_block(1,cols.size()==0 ? 0 : &cols[0],&ret,work);
+  return ret;
+}
+
+void calculator::eval_bytecode_block(size_t n, const double * const *cols,
+				     double *out,
+				     std::vector<double> &work) const {
+
+  if (bytecode.size()==0) {
+    throw std::domain_error
+      ("Bytecode not compiled in eval_bytecode_block().");
+  }
+  if (n==0) return;
+  if (work.size()<bc_depth*n) work.resize(bc_depth*n);
+
+  // The top of the stack, each stack entry is a block of n values
+  double *top=&work[0]-n;
+  
+  for(size_t ib=0;ib<bytecode.size();ib++) {
+    const bc_instr &ins=bytecode[ib];
+    
+    if (ins.op==bc_num) {
+      top+=n;
+      double val=ins.val;
+      for(size_t i=0;i<n;i++) top[i]=val;
+    } else if (ins.op==bc_var) {
+      top+=n;
+      const double *src=cols[ins.slot];
+      for(size_t i=0;i<n;i++) top[i]=src[i];
+    } else if (ins.op<bc_add) {
+      // Functions of one variable operate in place
+      double *x=top;
+      switch (ins.op) {
+      case bc_sin: for(size_t i=0;i<n;i++) x[i]=sin(x[i]); break;
+      case bc_cos: for(size_t i=0;i<n;i++) x[i]=cos(x[i]); break;
+      case bc_tan: for(size_t i=0;i<n;i++) x[i]=tan(x[i]); break;
+      case bc_sqrt: for(size_t i=0;i<n;i++) x[i]=sqrt(x[i]); break;
+      case bc_log: for(size_t i=0;i<n;i++) x[i]=log(x[i]); break;
+      case bc_exp: for(size_t i=0;i<n;i++) x[i]=exp(x[i]); break;
+      case bc_abs: for(size_t i=0;i<n;i++) x[i]=std::abs(x[i]); break;
+      case bc_log10: for(size_t i=0;i<n;i++) x[i]=log10(x[i]); break;
+      case bc_asin: for(size_t i=0;i<n;i++) x[i]=asin(x[i]); break;
+      case bc_acos: for(size_t i=0;i<n;i++) x[i]=acos(x[i]); break;
+      case bc_atan: for(size_t i=0;i<n;i++) x[i]=atan(x[i]); break;
+      case bc_sinh: for(size_t i=0;i<n;i++) x[i]=sinh(x[i]); break;
+      case bc_cosh: for(size_t i=0;i<n;i++) x[i]=cosh(x[i]); break;
+      case bc_tanh: for(size_t i=0;i<n;i++) x[i]=tanh(x[i]); break;
+      case bc_asinh: for(size_t i=0;i<n;i++) x[i]=asinh(x[i]); break;
+      case bc_acosh: for(size_t i=0;i<n;i++) x[i]=acosh(x[i]); break;
+      case bc_atanh: for(size_t i=0;i<n;i++) x[i]=atanh(x[i]); break;
+      case bc_floor: for(size_t i=0;i<n;i++) x[i]=floor(x[i]); break;
+      default:
+	throw std::domain_error("Invalid opcode.");
+      }
+    } else {
+      // Binary operators store the result in the left operand
+      const double *r=top;
+      top-=n;
+      double *l=top;
+      switch (ins.op) {
+      case bc_add: for(size_t i=0;i<n;i++) l[i]+=r[i]; break;
+      case bc_mul: for(size_t i=0;i<n;i++) l[i]*=r[i]; break;
+      case bc_sub: for(size_t i=0;i<n;i++) l[i]-=r[i]; break;
+      case bc_div: for(size_t i=0;i<n;i++) l[i]/=r[i]; break;
+      case bc_lshift:
+	for(size_t i=0;i<n;i++) l[i]=(int)l[i] << (int)r[i];
+	break;
+      case bc_pow: for(size_t i=0;i<n;i++) l[i]=pow(l[i],r[i]); break;
+      case bc_rshift:
+	for(size_t i=0;i<n;i++) l[i]=(int)l[i] >> (int)r[i];
+	break;
+      case bc_mod:
+	for(size_t i=0;i<n;i++) l[i]=(int)l[i] % (int)r[i];
+	break;
+      case bc_lt: for(size_t i=0;i<n;i++) l[i]=l[i]<r[i]; break;
+      case bc_gt: for(size_t i=0;i<n;i++) l[i]=l[i]>r[i]; break;
+      case bc_leq: for(size_t i=0;i<n;i++) l[i]=l[i]<=r[i]; break;
+      case bc_geq: for(size_t i=0;i<n;i++) l[i]=l[i]>=r[i]; break;
+      case bc_eq: for(size_t i=0;i<n;i++) l[i]=l[i]==r[i]; break;
+      case bc_neq: for(size_t i=0;i<n;i++) l[i]=l[i]!=r[i]; break;
+      case bc_and:
+	for(size_t i=0;i<n;i++) l[i]=(int)l[i] && (int)r[i];
+	break;
+      case bc_or:
+	for(size_t i=0;i<n;i++) l[i]=(int)l[i] || (int)r[i];
+	break;
+      default:
+	throw std::domain_error("Invalid opcode.");
+      }
+    }
+  }
+
+  for(size_t i=0;i<n;i++) out[i]=top[i];
+  
+  return;
 }
 
 double calculator::eval(std::map<std::string, double>* vars) {
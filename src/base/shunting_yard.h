@@ -60,6 +60,7 @@
 #include <stack>
 #include <string>
 #include <queue>
+#include <vector>
 
 namespace o2scl {
 
@@ -164,13 +165,55 @@ namespace o2scl {
      */
     TokenQueue_t RPN;
 
+    /** \brief Opcodes for the bytecode form of the expression
+     */
+    enum bc_opcode {bc_num, bc_var,
+		    bc_sin, bc_cos, bc_tan, bc_sqrt, bc_log, bc_exp,
+		    bc_abs, bc_log10, bc_asin, bc_acos, bc_atan, bc_sinh,
+		    bc_cosh, bc_tanh, bc_asinh, bc_acosh, bc_atanh,
+		    bc_floor, bc_add, bc_mul, bc_sub, bc_div, bc_lshift,
+		    bc_pow, bc_rshift, bc_mod, bc_lt, bc_gt, bc_leq,
+		    bc_geq, bc_eq, bc_neq, bc_and, bc_or};
+
+    /** \brief A map from operator names to bytecode opcodes
+     */
+    static std::map<std::string, bc_opcode> bcOps;
+
+    /** \brief Build the opcode map
+     */
+    static std::map<std::string, bc_opcode> buildBcOps();
+
+    /** \brief A single bytecode instruction
+     */
+    struct bc_instr {
+      /// The opcode
+      bc_opcode op;
+      /// The slot index (for \c bc_var only)
+      size_t slot;
+      /// The value (for \c bc_num only)
+      double val;
+    };
+
+    /** \brief The bytecode, empty if \ref compile_bytecode() has not
+	been called since the last \ref compile()
+     */
+    std::vector<bc_instr> bytecode;
+
+    /** \brief The slots referenced by the bytecode (sorted, unique)
+     */
+    std::vector<size_t> bc_slots;
+
+    /** \brief The maximum stack depth required by the bytecode
+     */
+    size_t bc_depth;
+
   public:
 
     ~calculator();
     
     /** \brief Create an empty calculator object
      */
-    calculator(){}
+    calculator() : bc_depth(0) {}
     
     /** \brief Compile expression \c expr using variables 
 	specified in \c vars
@@ -193,6 +236,58 @@ namespace o2scl {
      */
     double eval(std::map<std::string, double> *vars=0);
     
+    /** \brief Convert the previously compiled expression to 
+	slot-indexed bytecode
+
+	Each variable in the expression is resolved to its index in 
+	\c names, so that subsequent evaluations with \ref
+	eval_bytecode() or \ref eval_bytecode_block() require no
+	string comparisons or map lookups. If a variable is not
+	present in \c names, then <tt>std::domain_error</tt> is
+	thrown. The bytecode is cleared by the next call to 
+	\ref compile().
+    */
+    void compile_bytecode(const std::vector<std::string> &names);
+
+    /** \brief Return true if \ref compile_bytecode() has been 
+	called since the last call to \ref compile()
+    */
+    bool bytecode_compiled() const {
+      return bytecode.size()>0;
+    }
+
+    /** \brief Return the list of slots referenced by the bytecode
+	(sorted and without duplicates)
+    */
+    const std::vector<size_t> &bytecode_slots() const {
+      return bc_slots;
+    }
+
+    /** \brief Evaluate the bytecode for a single set of values
+	given in \c vals, indexed by slot
+    */
+    double eval_bytecode(const double *vals) const;
+
+    /** \brief Evaluate the bytecode for a block of \c n rows
+	
+	The pointer <tt>cols[k]</tt> must point to \c n contiguous
+	values for slot \c k, for every slot \c k returned by 
+	\ref bytecode_slots() (other pointers are not referenced). 
+	The results are stored in \c out. The vector \c work is
+	used as temporary storage and is resized if necessary, so
+	that repeated calls with the same \c work vector do not
+	allocate memory. 
+
+	The expression is evaluated one instruction at a time over
+	the entire block, so that each instruction is a simple loop
+	over contiguous memory which the compiler can vectorize.
+	This function is const and can be called by several 
+	threads simultaneously as long as each thread uses its own
+	\c work vector.
+    */
+    void eval_bytecode_block(size_t n, const double * const *cols,
+			     double *out, std::vector<double> &work) const;
+    
     /** \brief Convert the RPN expression to a string
 
 	\note This is mostly useful for debugging
@@ -149,6 +149,33 @@ int main(void) {
   cout << calc.RPN_to_string() << endl;
   t.test_rel(calc.eval(0),0.5,1.0e-14,"calc34");
 
+  // Test bytecode evaluation
+  std::map<std::string,double> vars;
+  vars["c"]=2.0;
+  calc.compile("c*sin(x)-y^2+(x<y)",&vars);
+  std::vector<std::string> names;
+  names.push_back("y");
+  names.push_back("z");
+  names.push_back("x");
+  calc.compile_bytecode(names);
+  t.test_gen(calc.bytecode_slots().size()==2,"bytecode slots");
+  double vals[3]={0.3,0.0,0.7};
+  vars["x"]=0.7;
+  vars["y"]=0.3;
+  t.test_rel(calc.eval_bytecode(vals),calc.eval(&vars),1.0e-15,"bytecode 1");
+  std::vector<double> xv(10), yv(10), res(10), work;
+  for(size_t i=0;i<10;i++) {
+    xv[i]=((double)i)/5.0;
+    yv[i]=1.0;
+  }
+  const double *cols[3]={&yv[0],0,&xv[0]};
+  calc.eval_bytecode_block(10,cols,&res[0],work);
+  for(size_t i=0;i<10;i++) {
+    vars["x"]=xv[i];
+    vars["y"]=yv[i];
+    t.test_rel(res[i],calc.eval(&vars),1.0e-15,"bytecode 2");
+  }
+
   t.report();
   return 0;
 }
@@ -33,6 +33,8 @@
 #include <cmath>
 #include <sstream>
 #include <map>
+#include <tuple>
+#include <mutex>
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
@@ -107,9 +109,12 @@ namespace o2scl {
 
       Lookup, differentiation, integration, and interpolation are
       automatically implemented using splines from the class \ref
-      interp_vec. A caching mechanism is implemented so that
-      successive interpolations, derivative evaluations or
-      integrations over the same two columns are fast.
+      interp_vec. The fitted interpolation objects are stored for
+      each pair of columns and interpolation type, so that
+      interpolations, derivative evaluations or integrations which
+      alternate between several pairs of columns do not require
+      refitting. The stored objects for a column are discarded
+      whenever the column is modified by a member function.
 
       <B> Sorting </b>\n
 
@@ -164,7 +169,10 @@ namespace o2scl {
       <b>Thread-safety</b> \n
 
       Generally, the member functions are only thread-safe 
-      if they are <tt>const</tt> .  
+      if they are <tt>const</tt> . The const interpolation functions,
+      e.g. \ref interp_const(), share the stored interpolation 
+      objects and may be called simultaneously from several threads
+      as long as no thread is modifying the table. 
 
       \b I/O \b and \b command-line \b manipulation \n
 
@@ -198,7 +206,6 @@ namespace o2scl {
    */
   table(size_t cmaxlines=0) {
     nlines=0;
-    intp_set=false;
     maxlines=cmaxlines;
     itype=itp_cspline;
   }
@@ -206,9 +213,7 @@ namespace o2scl {
   /** \brief Table destructor
    */
   virtual ~table() {
-    if (intp_set==true) {
-      delete si;
-    }
+    reset_interp();
   }
 
   /// Copy constructor
@@ -246,8 +251,6 @@ namespace o2scl {
     
     }
 
-    intp_set=false;
-
     is_valid();
     
     return;
@@ -292,10 +295,7 @@ namespace o2scl {
 	
       }
       
-      if (intp_set) {
-	intp_set=false;
-	delete si;
-      }
+      reset_interp();
       
     }
 
@@ -332,10 +332,7 @@ namespace o2scl {
       return;
     }
 
-    if ((intp_colx==scol || intp_coly==scol) && intp_set==true) {
-      delete si;
-      intp_set=false;
-    }
+    reset_interp(scol);
 
 #if !O2SCL_NO_RANGE_CHECK
     if (row>=it->second.dat.size()) {
@@ -366,10 +363,7 @@ namespace o2scl {
     }
 
     std::string scol=get_column_name(icol);
-    if ((intp_colx==scol || intp_coly==scol) && intp_set==true) {
-      delete si;
-      intp_set=false;
-    }
+    reset_interp(scol);
 
 #if !O2SCL_NO_RANGE_CHECK
     if (row>=alist[icol]->second.dat.size()) {
@@ -399,6 +393,7 @@ namespace o2scl {
     for(size_t i=0;i<get_ncolumns() && i<v.size();i++) {
       alist[i]->second.dat[row]=v[i];
     }
+    reset_interp();
     return;
   }
 
@@ -477,11 +472,8 @@ namespace o2scl {
     // Now that maxlines is large enough, set the number of lines 
     nlines=il;
       
-    // Reset the interpolation object for future interpolations
-    if (intp_set) {
-      intp_set=false;
-      delete si;
-    }
+    // Reset the interpolation objects for future interpolations
+    reset_interp();
       
     return;
   }
@@ -571,11 +563,8 @@ namespace o2scl {
     // Now that maxlines is large enough, set the number of lines 
     nlines=il;
       
-    // Reset the interpolation object for future interpolations
-    if (intp_set) {
-      intp_set=false;
-      delete si;
-    }
+    // Reset the interpolation objects for future interpolations
+    reset_interp();
       
     return;
   }
@@ -609,6 +598,9 @@ namespace o2scl {
   
     maxlines+=llines;
 
+    // The column data may have been reallocated
+    reset_interp();
+
     return;
   }
 
@@ -653,6 +645,9 @@ namespace o2scl {
   
     maxlines=llines;
 
+    // The column data may have been reallocated
+    reset_interp();
+
     return;
   }
   //@}
@@ -848,6 +843,7 @@ namespace o2scl {
 		 "table::swap_column_data().",exc_einval);
     }
     std::swap(its->second.dat,v);
+    reset_interp(scol);
     return;
   }
 
@@ -901,10 +897,7 @@ namespace o2scl {
     // Reset the list to reflect the proper iterators
     reset_list();
       
-    if ((intp_colx==scol || intp_coly==scol) && intp_set==true) {
-      delete si;
-      intp_set=false;
-    }
+    reset_interp(scol);
 
     return;
   }
@@ -947,10 +940,7 @@ namespace o2scl {
     for(size_t i=0;i<nlines;i++) {
       it->second.dat[i]=val;
     }
-    if (intp_set && (scol==intp_colx || scol==intp_coly)) {
-      intp_set=false;
-      delete si;
-    }
+    reset_interp(scol);
     return;
   }
 
@@ -1003,6 +993,7 @@ namespace o2scl {
     for(size_t i=0;i<nlines;i++) {
       itd->second.dat[i]=its->second.dat[i];
     }
+    reset_interp(dest);
     return;
   }
 
@@ -1124,10 +1115,7 @@ namespace o2scl {
       copy_row(i,i+1);
     }
 
-    if (intp_set) {
-      intp_set=false;
-      delete si;
-    }
+    reset_interp();
 
     return;
   }
@@ -1143,10 +1131,7 @@ namespace o2scl {
     for(int i=0;i<((int)atree.size());i++) {
       set(i,dest,get(i,src));
     }
-    if (intp_set) {
-      intp_set=false;
-      delete si;
-    }
+    reset_interp();
     return;
   }
 
@@ -1182,10 +1167,7 @@ namespace o2scl {
       }
     }
     nlines--;
-    if (intp_set==true) {
-      delete si;
-      intp_set=false;
-    }
+    reset_interp();
     return;
   }
 
@@ -1213,10 +1195,7 @@ namespace o2scl {
       }
     }
     nlines=new_nlines;
-    if (intp_set==true) {
-      delete si;
-      intp_set=false;
-    }
+    reset_interp();
     return;
   }
 
@@ -1287,10 +1266,7 @@ namespace o2scl {
       }
     }
     nlines=new_nlines;
-    if (intp_set==true) {
-      delete si;
-      intp_set=false;
-    }
+    reset_interp();
     return;
   }
   
@@ -1332,10 +1308,7 @@ namespace o2scl {
     
     // Set the new line number and reset the interpolator
     nlines=new_nlines;
-    if (intp_set==true) {
-      delete si;
-      intp_set=false;
-    }
+    reset_interp();
     
     return;
   }
@@ -1457,10 +1430,7 @@ namespace o2scl {
     if (maxlines==0) inc_maxlines(1);
     if (nlines>=maxlines) inc_maxlines(maxlines);
     
-    if (intp_set) {
-      intp_set=false;
-      delete si;
-    }
+    reset_interp();
       
     if (nlines<maxlines && nv<=(atree.size())) {
 
@@ -1635,10 +1605,7 @@ namespace o2scl {
   /// Set the base interpolation objects
   void set_interp_type(size_t interp_type) {
     itype=interp_type;
-    if (intp_set) {
-      delete si;
-      intp_set=false;
-    }
+    reset_interp();
     return;
   }
 
@@ -1668,18 +1635,7 @@ namespace o2scl {
       O2SCL_ERR("x0 not finite in table::interp().",exc_einval);
       return exc_einval;
     }
-    if (intp_set==false || sx!=intp_colx || sy!=intp_coly) {
-      if (intp_set==true) {
-	delete si;
-      } else {
-	intp_set=true;
-      }
-      si=new interp_vec<vec_t>(nlines,itx->second.dat,
-			       ity->second.dat,itype);
-      intp_colx=sx;
-      intp_coly=sy;
-    }
-    ret=si->eval(x0);
+    ret=get_interp(sx,itx->second.dat,sy,ity->second.dat)->eval(x0);
     return ret;
   }
 
@@ -1703,9 +1659,7 @@ namespace o2scl {
       O2SCL_ERR("x0 not finite in table::interp_const().",exc_einval);
       return exc_einval;
     }
-    interp_vec<vec_t> sic(nlines,itx->second.dat,ity->second.dat,itype);
-
-    ret=sic.interp(x0);
+    ret=get_interp(sx,itx->second.dat,sy,ity->second.dat)->eval(x0);
     return ret;
   }
     
@@ -1755,6 +1709,7 @@ namespace o2scl {
     for(int i=0;i<((int)nlines);i++) {
       ityp->second.dat[i]=deriv(ix,(itx->second.dat)[i],iy);
     }
+    reset_interp(yp);
   
     return;
   }
@@ -1780,19 +1735,7 @@ namespace o2scl {
 		exc_einval);
       return exc_einval;
     }
-    if (intp_set==false || sx!=intp_colx || sy!=intp_coly) {
-      if (intp_set==true) {
-	delete si;
-      } else {
-	intp_set=true;
-      }
-      si=new interp_vec<vec_t>
-      (nlines,itx->second.dat,ity->second.dat,itype);
-			 
-      intp_colx=sx;
-      intp_coly=sy;
-    }
-    ret=si->deriv(x0);
+    ret=get_interp(sx,itx->second.dat,sy,ity->second.dat)->deriv(x0);
     return ret;
   }
 
@@ -1816,9 +1759,7 @@ namespace o2scl {
       O2SCL_ERR("x0 not finite in table::deriv_const().",exc_einval);
       return exc_einval;
     }
-    interp_vec<vec_t> sic
-    (nlines,itx->second.dat,ity->second.dat,itype);
-    ret=sic.deriv(x0);
+    ret=get_interp(sx,itx->second.dat,sy,ity->second.dat)->deriv(x0);
     return ret;
   }
   
@@ -1876,6 +1817,7 @@ namespace o2scl {
     for(int i=0;i<((int)nlines);i++) {
       ityp->second.dat[i]=deriv2(ix,itx->second.dat[i],iy);
     }
+    reset_interp(yp);
   
     return;
   }
@@ -1901,19 +1843,7 @@ namespace o2scl {
 		exc_einval);
       return exc_einval;
     }
-    if (intp_set==false || sx!=intp_colx || sy!=intp_coly) {
-      if (intp_set==true) {
-	delete si;
-      } else {
-	intp_set=true;
-      }
-      si=new interp_vec<vec_t>
-      (nlines,itx->second.dat,ity->second.dat,itype);
-			 
-      intp_colx=sx;
-      intp_coly=sy;
-    }
-    ret=si->deriv2(x0);
+    ret=get_interp(sx,itx->second.dat,sy,ity->second.dat)->deriv2(x0);
     return ret;
   }
 
@@ -1937,9 +1867,7 @@ namespace o2scl {
       O2SCL_ERR("x0 not finite in table::deriv2_const().",exc_einval);
       return exc_einval;
     }
-    interp_vec<vec_t> sic
-    (nlines,itx->second.dat,ity->second.dat,itype);
-    ret=sic.deriv2(x0);
+    ret=get_interp(sx,itx->second.dat,sy,ity->second.dat)->deriv2(x0);
     return ret;
   }
 
@@ -1987,19 +1915,7 @@ namespace o2scl {
       dtos(x2)+" not finite in table.integ(string,double,double,string).";
       O2SCL_ERR(msg.c_str(),exc_einval);
     }
-    if (intp_set==false || sx!=intp_colx || sy!=intp_coly) {
-      if (intp_set==true) {
-	delete si;
-      } else {
-	intp_set=true;
-      }
-      si=new interp_vec<vec_t>
-      (nlines,itx->second.dat,ity->second.dat,itype);
-			 
-      intp_colx=sx;
-      intp_coly=sy;
-    }
-    ret=si->integ(x1,x2);
+    ret=get_interp(sx,itx->second.dat,sy,ity->second.dat)->integ(x1,x2);
     return ret;
   }
   
@@ -2025,9 +1941,7 @@ namespace o2scl {
       O2SCL_ERR("x1 or x2 not finite in table::integ_const().",exc_einval);
       return exc_einval;
     }
-    interp_vec<vec_t> sic
-    (nlines,itx->second.dat,ity->second.dat,itype);
-    ret=sic.integ(x1,x2);
+    ret=get_interp(sx,itx->second.dat,sy,ity->second.dat)->integ(x1,x2);
     return ret;
   }
   
@@ -2091,6 +2005,7 @@ namespace o2scl {
       itynew->second.dat[i]=integ(ix,(itx->second.dat)[0],
 				  (itx->second.dat)[i],iy);
     }
+    reset_interp(ynew);
   
     return;
   }
@@ -2237,10 +2152,7 @@ namespace o2scl {
       }
     }
 
-    if (intp_set) {
-      intp_set=false;
-      delete si;
-    }
+    reset_interp();
 
     return;
   }
@@ -2259,10 +2171,7 @@ namespace o2scl {
     atree.clear();
     alist.clear();
     nlines=0;
-    if (intp_set==true) {
-      delete si;
-      intp_set=false;
-    }
+    reset_interp();
     return;
   }
 
@@ -2274,10 +2183,7 @@ namespace o2scl {
   */
   void clear_data() {
     nlines=0;   
-    if (intp_set==true) {
-      delete si; 
-      intp_set=false;
-    }
+    reset_interp();
     return;
   }
 
@@ -2319,10 +2225,7 @@ namespace o2scl {
       }
     }
   
-    if (intp_set) {
-      intp_set=false;
-      delete si;
-    }
+    reset_interp();
 
     return;
   }
@@ -2341,10 +2244,7 @@ namespace o2scl {
 
     vector_sort_double(nlines,it->second.dat);
 
-    if (intp_set && (scol==intp_colx || scol==intp_coly)) {
-      intp_set=false;
-      delete si;
-    }
+    reset_interp(scol);
 
     return;
   }
@@ -2583,10 +2483,7 @@ namespace o2scl {
       irow++;
     }
 
-    if (intp_set) {
-      intp_set=false;
-      delete si;
-    }
+    reset_interp();
 
     return 0;
   }
@@ -2719,18 +2616,11 @@ namespace o2scl {
       newcols[j].resize(maxlines);
     }
     
-    // Calculate all of the columns in the newcols list:
-    for(size_t i=0;i<nlines;i++) {
-      
-      // Record the values of the variables for this line:
-      for(size_t j=0;j<atree.size();j++) {
-	vars[get_column_name(j)]=(*this)[j][i];
-      }
-      
-      // Evaluate the new columns
-      for(size_t j=0;j<funcs.size();j++) {
-	newcols[j][i]=calcs[j].eval(&vars);
-      }
+    // Calculate all of the columns in the newcols list. All of the
+    // new columns are computed from the original table before
+    // any of them are stored.
+    for(size_t j=0;j<funcs.size();j++) {
+      calc_column_blocks(calcs[j],newcols[j]);
     }
 
     for(size_t j=0;j<funcs.size();j++) {
@@ -2766,6 +2656,7 @@ namespace o2scl {
 
     // Fill vector with result of function
     function_vector(function,colp);
+    reset_interp(scol);
 
     return;
   }
@@ -2799,16 +2690,8 @@ namespace o2scl {
     // Resize vector if necessary
     if (vec.size()<nlines) vec.resize(nlines);
 
-    // Create space for column values
-    std::vector<double> vals(atree.size());
-  
     // Create column from function
-    for(size_t j=0;j<nlines;j++) {
-      for(aciter it=atree.begin();it!=atree.end();it++) {
-	vars[it->first]=it->second.dat[j];
-      }
-      vec[j]=calc.eval(&vars);
-    }
+    calc_column_blocks(calc,vec);
 
     return 0;
   }
@@ -2906,8 +2789,81 @@ namespace o2scl {
 		exc_enotfound);
       return empty_col;
     }
+    reset_interp(scol);
     return it->second.dat;
   }
+  /** \brief Evaluate the expression in \c calc for every row
+      and store the results in \c vec
+
+      The expression is converted to bytecode with the variables
+      resolved to column indices, and then evaluated over blocks of
+      \ref calc_block_size rows at a time. Only the columns which
+      are referenced by the expression are copied into the
+      contiguous block buffers. If <tt>O2SCL_OPENMP</tt> is
+      defined, the blocks are distributed among the OpenMP
+      threads, each with its own buffers. The vector \c vec must
+      already have at least \ref get_nlines() elements.
+  */
+  template<class resize_vec_t>
+  void calc_column_blocks(calculator &calc, resize_vec_t &vec) const {
+
+    // Resolve variable names to column indices
+    size_t ncols=alist.size();
+    std::vector<std::string> names(ncols);
+    std::vector<const vec_t *> col_ptrs(ncols);
+    for(size_t j=0;j<ncols;j++) {
+      names[j]=alist[j]->first;
+      col_ptrs[j]=&(alist[j]->second.dat);
+    }
+    calc.compile_bytecode(names);
+
+    const std::vector<size_t> &slots=calc.bytecode_slots();
+    size_t nslots=slots.size();
+    size_t nblocks=(nlines+calc_block_size-1)/calc_block_size;
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel default(shared) if (nblocks>1)
+#endif
+    {
+      // Thread-local storage for the block of input columns, the
+      // output, and the evaluation stack
+      std::vector<double> in(nslots*calc_block_size);
+      std::vector<double> out(calc_block_size), work;
+      std::vector<const double *> in_ptrs(ncols,0);
+      for(size_t k=0;k<nslots;k++) {
+	in_ptrs[slots[k]]=&in[k*calc_block_size];
+      }
+      
+#ifdef O2SCL_OPENMP
+#pragma omp for
+#endif
+      for(size_t ib=0;ib<nblocks;ib++) {
+	
+	size_t row0=ib*calc_block_size;
+	size_t n=calc_block_size;
+	if (row0+n>nlines) n=nlines-row0;
+	
+	// Copy the referenced columns into contiguous storage
+	for(size_t k=0;k<nslots;k++) {
+	  const vec_t &col=*(col_ptrs[slots[k]]);
+	  double *dest=&in[k*calc_block_size];
+	  for(size_t i=0;i<n;i++) dest[i]=col[row0+i];
+	}
+	
+	calc.eval_bytecode_block(n,&in_ptrs[0],&out[0],work);
+	
+	for(size_t i=0;i<n;i++) vec[row0+i]=out[i];
+      }
+    }
+    
+    return;
+  }
+
+  /** \brief The number of rows evaluated at a time in 
+      \ref calc_column_blocks()
+  */
+  static const size_t calc_block_size=256;
+  
   /** \brief Set the elements of alist with the appropriate 
       iterators from atree. \f$ {\cal O}(C) \f$
 
@@ -3058,20 +3014,68 @@ namespace o2scl {
 
   /// \name Interpolation
   //@{
-  /// True if the interpolation object is up-to-date
-  bool intp_set;
-    
   /// Current interpolation type
   size_t itype;
 
-  /// Interpolation object
-  interp_vec<vec_t> *si;
+  /// Key for \ref intp_cache: x-column, y-column, and type
+  typedef std::tuple<std::string,std::string,size_t> intp_key;
+
+  /** \brief Interpolation objects which have already been 
+      fit, one for each combination of columns and type
+  */
+  mutable std::map<intp_key,interp_vec<vec_t> *> intp_cache;
+
+  /// Lock for \ref intp_cache in the const member functions
+  mutable std::mutex intp_mutex;
+
+  /** \brief Return the interpolation object for x-column \c sx
+      with data \c xdat and y-column \c sy with data \c ydat,
+      fitting it if necessary
+
+      The returned object remains valid until the next call to
+      \ref reset_interp(), and its evaluation functions may be 
+      called simultaneously from several threads.
+  */
+  const interp_vec<vec_t> *get_interp(std::string sx, const vec_t &xdat,
+				      std::string sy,
+				      const vec_t &ydat) const {
+    std::lock_guard<std::mutex> lock(intp_mutex);
+    intp_key key(sx,sy,itype);
+    typename std::map<intp_key,interp_vec<vec_t> *>::iterator it=
+      intp_cache.find(key);
+    if (it!=intp_cache.end()) return it->second;
+    interp_vec<vec_t> *si=new interp_vec<vec_t>(nlines,xdat,ydat,itype);
+    intp_cache.insert(std::make_pair(key,si));
+    return si;
+  }
 
-  /// The last x-column interpolated
-  std::string intp_colx;
+  /// Delete all of the interpolation objects
+  void reset_interp() {
+    typename std::map<intp_key,interp_vec<vec_t> *>::iterator it;
+    for(it=intp_cache.begin();it!=intp_cache.end();it++) {
+      delete it->second;
+    }
+    intp_cache.clear();
+    return;
+  }
 
-  /// The last y-column interpolated
-  std::string intp_coly;
+  /** \brief Delete the interpolation objects which refer to
+      column \c scol
+  */
+  void reset_interp(std::string scol) {
+    if (intp_cache.empty()) return;
+    typename std::map<intp_key,interp_vec<vec_t> *>::iterator it=
+      intp_cache.begin();
+    while (it!=intp_cache.end()) {
+      if (std::get<0>(it->first)==scol || std::get<1>(it->first)==scol) {
+	delete it->second;
+	intp_cache.erase(it++);
+      } else {
+	it++;
+      }
+    }
+    return;
+  }
   //@}
 
 #endif
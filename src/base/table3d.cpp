@@ -36,6 +36,7 @@ table3d::table3d() {
   size_set=false;
   has_slice=false;
   itype=itp_cspline;
+  icache_grid=false;
 }
 
 table3d::~table3d() {
@@ -58,6 +59,7 @@ table3d::table3d(table_units<> &t, std::string colx, std::string coly) {
   size_set=false;
   has_slice=false;
   itype=itp_cspline;
+  icache_grid=false;
   
   // Create grid vectors
 
@@ -136,6 +138,8 @@ table3d::table3d(table_units<> &t, std::string colx, std::string coly) {
 }
 
 table3d::table3d(const table3d &t) {
+
+  icache_grid=false;
       
   // Copy constants
   constants=t.constants;
@@ -241,6 +245,7 @@ void table3d::set_xy(std::string x_name, uniform_grid<double> gx,
   gy.vector(yval);
   size_set=true;
   xy_set=true;
+  clear_interp_cache();
 }
 
 int table3d::read_gen3_list(std::istream &fin, int verbose, double eps) {
@@ -498,12 +503,14 @@ void table3d::set_slice_all(std::string name, double val) {
       (list[z])(i,j)=val;
     }
   }
+  cache_invalidate(z);
   return;
 }
 
 void table3d::set(size_t ix, size_t iy, std::string name, double val) {
   size_t z=lookup_slice(name);
   (list[z])(ix,iy)=val;
+  cache_invalidate(z);
   return;
 }
 
@@ -514,6 +521,7 @@ void table3d::set_val(double x, double y, std::string name, double val) {
   
   size_t z=lookup_slice(name);
   (list[z])(ix,iy)=val;
+  cache_invalidate(z);
   return;
 }
     
@@ -526,11 +534,13 @@ void table3d::set_val_ret(double &x, double &y, std::string name, double val) {
 
   size_t z=lookup_slice(name);
   (list[z])(ix,iy)=val;
+  cache_invalidate(z);
   return;
 }
     
 void table3d::set(size_t ix, size_t iy, size_t z, double val) {
   (list[z])(ix,iy)=val;
+  cache_invalidate(z);
   return;
 }
 
@@ -542,6 +552,7 @@ void table3d::set_val(double x, double y, size_t z, double val) {
   y=yval[iy];
   
   (list[z])(ix,iy)=val;
+  cache_invalidate(z);
   return;
 }
     
@@ -551,11 +562,13 @@ void table3d::set_val_ret(double &x, double &y, size_t z, double val) {
   lookup_y(y,iy);
 
   (list[z])(ix,iy)=val;
+  cache_invalidate(z);
   return;
 }
     
 double &table3d::get(size_t ix, size_t iy, std::string name) {
   size_t z=lookup_slice(name);
+  cache_invalidate(z);
   return (list[z])(ix,iy);
 }
 
@@ -571,6 +584,7 @@ double &table3d::get_val_ret(double &x, double &y, std::string name) {
   x=xval[ix];
   y=yval[iy];
   size_t z=lookup_slice(name);
+  cache_invalidate(z);
   return (list[z])(ix,iy);
 }
 
@@ -590,6 +604,7 @@ double &table3d::get_val(double x, double y, std::string name) {
   lookup_x(x,ix);
   lookup_y(y,iy);
   size_t z=lookup_slice(name);
+  cache_invalidate(z);
   return (list[z])(ix,iy);
 }
     
@@ -602,6 +617,7 @@ const double &table3d::get_val(double x, double y, std::string name) const {
 }
     
 double &table3d::get(size_t ix, size_t iy, size_t z) {
+  cache_invalidate(z);
   return (list[z])(ix,iy);
 }
 
@@ -615,6 +631,7 @@ double &table3d::get_val_ret(double &x, double &y, size_t z) {
   lookup_y(y,iy);
   x=xval[ix];
   y=yval[iy];
+  cache_invalidate(z);
   return (list[z])(ix,iy);
 }
 
@@ -631,6 +648,7 @@ double &table3d::get_val(double x, double y, size_t z) {
   size_t ix=0, iy=0;
   lookup_x(x,ix);
   lookup_y(y,iy);
+  cache_invalidate(z);
   return (list[z])(ix,iy);
 }
 
@@ -644,6 +662,7 @@ const double &table3d::get_val(double x, double y, size_t z) const {
 void table3d::set_grid_x(size_t ix, double val) {
   if (ix<numx) {
     (xval)[ix]=val;
+    clear_interp_cache();
     return;
   }
   O2SCL_ERR((((string)"Index '")+itos(ix)+"' out of range ('"+itos(numx)+
@@ -654,6 +673,7 @@ void table3d::set_grid_x(size_t ix, double val) {
 void table3d::set_grid_y(size_t iy, double val) {
   if (iy<numy) {
     (yval)[iy]=val;
+    clear_interp_cache();
     return;
   }
   O2SCL_ERR((((string)"Index '")+itos(iy)+"' out of range ('"+itos(numy)+
@@ -727,6 +747,7 @@ void table3d::new_slice(std::string name) {
   }
   ubmatrix mp(numx,numy);
   list.push_back(mp);
+  icache.push_back(slice_cache());
   tree.insert(make_pair(name,list.size()-1));
   has_slice=true;
   return;
@@ -797,6 +818,7 @@ void table3d::init_slice(std::string scol, double val) {
       (list[sl1])(i,j)=val;
     }
   }
+  cache_invalidate(sl1);
   return;
 }
   
@@ -854,6 +876,7 @@ void table3d::lookup(double val, std::string slice, size_t &ix,
 }
 
 void table3d::set_interp_type(size_t interp_type) {
+  if (interp_type!=itype) clear_interp_cache();
   itype=interp_type;
   return;
 }
@@ -862,10 +885,190 @@ size_t table3d::get_interp_type() const {
   return itype;
 }
 
+void table3d::clear_interp_cache() {
+  for(size_t i=0;i<icache.size();i++) {
+    icache[i].valid=false;
+  }
+  icache_grid=false;
+  return;
+}
+
+bool table3d::cache_usable() const {
+  if (!xy_set) return false;
+  if (itype==itp_linear) {
+    return (numx>=2 && numy>=2);
+  }
+  if (itype==itp_cspline || itype==itp_cspline_peri) {
+    return (numx>=3 && numy>=3);
+  }
+  return false;
+}
+
+const table3d::slice_cache &table3d::cache_get(size_t z) const {
+  
+  std::lock_guard<std::mutex> lock(icache_mutex);
+
+  if (z>=icache.size()) {
+    O2SCL_ERR("Cache not allocated in table3d::cache_get().",exc_esanity);
+  }
+  
+  if (!icache_grid) {
+    icache_svx.set_vec(numx,xval);
+    icache_svy.set_vec(numy,yval);
+    icache_grid=true;
+  }
+  
+  slice_cache &c=icache[z];
+  if (c.valid) return c;
+
+  const ubmatrix &d=list[z];
+  c.zxx.resize(numx,numy);
+  c.zyy.resize(numx,numy);
+  c.zxxyy.resize(numx,numy);
+  
+  if (itype==itp_linear) {
+    
+    for(size_t i=0;i<numx;i++) {
+      for(size_t j=0;j<numy;j++) {
+	c.zxx(i,j)=0.0;
+	c.zyy(i,j)=0.0;
+	c.zxxyy(i,j)=0.0;
+      }
+    }
+    
+  } else {
+
+    // The interpolation is linear in the data, so the mixed
+    // derivative can be obtained by interpolating zxx in y
+    
+    interp_vec<ubvector,ubmatrix_column> itc;
+    for(size_t j=0;j<numy;j++) {
+      ubmatrix_column col(d,j);
+      itc.set(numx,xval,col,itype);
+      for(size_t i=0;i<numx;i++) {
+	c.zxx(i,j)=itc.deriv2(xval[i]);
+      }
+    }
+    
+    interp_vec<ubvector,ubmatrix_row> itr;
+    for(size_t i=0;i<numx;i++) {
+      ubmatrix_row row(d,i);
+      itr.set(numy,yval,row,itype);
+      for(size_t j=0;j<numy;j++) {
+	c.zyy(i,j)=itr.deriv2(yval[j]);
+      }
+      ubmatrix_row row2(c.zxx,i);
+      itr.set(numy,yval,row2,itype);
+      for(size_t j=0;j<numy;j++) {
+	c.zxxyy(i,j)=itr.deriv2(yval[j]);
+      }
+    }
+    
+  }
+
+  // Cumulative integrals in x
+  c.ix_z.resize(numx,numy);
+  c.ix_zyy.resize(numx,numy);
+  for(size_t j=0;j<numy;j++) {
+    c.ix_z(0,j)=0.0;
+    c.ix_zyy(0,j)=0.0;
+    for(size_t i=0;i<numx-1;i++) {
+      double h=xval[i+1]-xval[i];
+      double h3=h*h*h/24.0;
+      c.ix_z(i+1,j)=c.ix_z(i,j)+h*(d(i,j)+d(i+1,j))/2.0-
+	h3*(c.zxx(i,j)+c.zxx(i+1,j));
+      c.ix_zyy(i+1,j)=c.ix_zyy(i,j)+h*(c.zyy(i,j)+c.zyy(i+1,j))/2.0-
+	h3*(c.zxxyy(i,j)+c.zxxyy(i+1,j));
+    }
+  }
+  
+  // Cumulative integrals in y
+  c.iy_z.resize(numx,numy);
+  c.iy_zxx.resize(numx,numy);
+  for(size_t i=0;i<numx;i++) {
+    c.iy_z(i,0)=0.0;
+    c.iy_zxx(i,0)=0.0;
+    for(size_t j=0;j<numy-1;j++) {
+      double h=yval[j+1]-yval[j];
+      double h3=h*h*h/24.0;
+      c.iy_z(i,j+1)=c.iy_z(i,j)+h*(d(i,j)+d(i,j+1))/2.0-
+	h3*(c.zyy(i,j)+c.zyy(i,j+1));
+      c.iy_zxx(i,j+1)=c.iy_zxx(i,j)+h*(c.zxx(i,j)+c.zxx(i,j+1))/2.0-
+	h3*(c.zxxyy(i,j)+c.zxxyy(i,j+1));
+    }
+  }
+  
+  c.valid=true;
+  
+  return c;
+}
+
+void table3d::cache_weights(const ubvector &grid,
+			    const search_vec<const ubvector> &sv,
+			    double x0, size_t &i, double w[4],
+			    bool deriv) const {
+  size_t cache=0;
+  i=sv.find_const(x0,cache);
+  double h=grid[i+1]-grid[i];
+  double b=(x0-grid[i])/h;
+  double a=1.0-b;
+  if (deriv) {
+    w[0]=-1.0/h;
+    w[1]=1.0/h;
+    w[2]=-(3.0*a*a-1.0)*h/6.0;
+    w[3]=(3.0*b*b-1.0)*h/6.0;
+  } else {
+    w[0]=a;
+    w[1]=b;
+    w[2]=(a*a-1.0)*a*h*h/6.0;
+    w[3]=(b*b-1.0)*b*h*h/6.0;
+  }
+  return;
+}
+
+void table3d::cache_integ_weights(const ubvector &grid,
+				  const search_vec<const ubvector> &sv,
+				  double x0, size_t &i, double w[4]) const {
+  size_t cache=0;
+  i=sv.find_const(x0,cache);
+  double h=grid[i+1]-grid[i];
+  double b=(x0-grid[i])/h;
+  double a=1.0-b;
+  double h3=h*h*h/24.0;
+  w[0]=h*b*(1.0-b/2.0);
+  w[1]=h*b*b/2.0;
+  w[2]=-h3*(1.0-a*a)*(1.0-a*a);
+  w[3]=h3*b*b*(b*b-2.0);
+  return;
+}
+
+double table3d::cache_eval(size_t z, const slice_cache &c, size_t i,
+			   size_t j, const double wx[4],
+			   const double wy[4]) const {
+  const ubmatrix &d=list[z];
+  double res=0.0;
+  for(size_t q=0;q<2;q++) {
+    res+=wy[q]*(wx[0]*d(i,j+q)+wx[1]*d(i+1,j+q)+
+		wx[2]*c.zxx(i,j+q)+wx[3]*c.zxx(i+1,j+q));
+    res+=wy[q+2]*(wx[0]*c.zyy(i,j+q)+wx[1]*c.zyy(i+1,j+q)+
+		  wx[2]*c.zxxyy(i,j+q)+wx[3]*c.zxxyy(i+1,j+q));
+  }
+  return res;
+}
+
 double table3d::interp(double x, double y, std::string name) const {
   double result;
   
   size_t z=lookup_slice(name);
+
+  if (cache_usable()) {
+    const slice_cache &c=cache_get(z);
+    size_t i, j;
+    double wx[4], wy[4];
+    cache_weights(xval,icache_svx,x,i,wx,false);
+    cache_weights(yval,icache_svy,y,j,wy,false);
+    return cache_eval(z,c,i,j,wx,wy);
+  }
   
   interp_vec<ubvector,ubmatrix_column> itp;
   
@@ -939,6 +1142,15 @@ double table3d::deriv_x(double x, double y, std::string name) const {
   double result;
   
   size_t z=lookup_slice(name);
+
+  if (cache_usable()) {
+    const slice_cache &c=cache_get(z);
+    size_t i, j;
+    double wx[4], wy[4];
+    cache_weights(xval,icache_svx,x,i,wx,true);
+    cache_weights(yval,icache_svy,y,j,wy,false);
+    return cache_eval(z,c,i,j,wx,wy);
+  }
   
   interp_vec<ubvector,ubmatrix_column> itp;
 
@@ -959,6 +1171,15 @@ double table3d::deriv_y(double x, double y, std::string name) const {
   double result;
   
   size_t z=lookup_slice(name);
+
+  if (cache_usable()) {
+    const slice_cache &c=cache_get(z);
+    size_t i, j;
+    double wx[4], wy[4];
+    cache_weights(xval,icache_svx,x,i,wx,false);
+    cache_weights(yval,icache_svy,y,j,wy,true);
+    return cache_eval(z,c,i,j,wx,wy);
+  }
   
   interp_vec<ubvector,ubmatrix_column> itp;
 
@@ -980,6 +1201,30 @@ double table3d::integ_x(double x1, double x2, double y,
   double result;
   
   size_t z=lookup_slice(name);
+
+  if (cache_usable()) {
+    const slice_cache &c=cache_get(z);
+    const ubmatrix &d=list[z];
+    size_t j, k1, k2;
+    double wy[4], a1[4], a2[4];
+    cache_weights(yval,icache_svy,y,j,wy,false);
+    cache_integ_weights(xval,icache_svx,x1,k1,a1);
+    cache_integ_weights(xval,icache_svx,x2,k2,a2);
+    result=0.0;
+    for(size_t q=0;q<2;q++) {
+      size_t jq=j+q;
+      double f1=c.ix_z(k1,jq)+a1[0]*d(k1,jq)+a1[1]*d(k1+1,jq)+
+	a1[2]*c.zxx(k1,jq)+a1[3]*c.zxx(k1+1,jq);
+      double f2=c.ix_z(k2,jq)+a2[0]*d(k2,jq)+a2[1]*d(k2+1,jq)+
+	a2[2]*c.zxx(k2,jq)+a2[3]*c.zxx(k2+1,jq);
+      double g1=c.ix_zyy(k1,jq)+a1[0]*c.zyy(k1,jq)+a1[1]*c.zyy(k1+1,jq)+
+	a1[2]*c.zxxyy(k1,jq)+a1[3]*c.zxxyy(k1+1,jq);
+      double g2=c.ix_zyy(k2,jq)+a2[0]*c.zyy(k2,jq)+a2[1]*c.zyy(k2+1,jq)+
+	a2[2]*c.zxxyy(k2,jq)+a2[3]*c.zxxyy(k2+1,jq);
+      result+=wy[q]*(f2-f1)+wy[q+2]*(g2-g1);
+    }
+    return result;
+  }
   
   interp_vec<ubvector,ubmatrix_row> itp;
 
@@ -1001,6 +1246,30 @@ double table3d::integ_y(double x, double y1, double y2,
   double result;
   
   size_t z=lookup_slice(name);
+
+  if (cache_usable()) {
+    const slice_cache &c=cache_get(z);
+    const ubmatrix &d=list[z];
+    size_t i, k1, k2;
+    double wx[4], a1[4], a2[4];
+    cache_weights(xval,icache_svx,x,i,wx,false);
+    cache_integ_weights(yval,icache_svy,y1,k1,a1);
+    cache_integ_weights(yval,icache_svy,y2,k2,a2);
+    result=0.0;
+    for(size_t p=0;p<2;p++) {
+      size_t ip=i+p;
+      double f1=c.iy_z(ip,k1)+a1[0]*d(ip,k1)+a1[1]*d(ip,k1+1)+
+	a1[2]*c.zyy(ip,k1)+a1[3]*c.zyy(ip,k1+1);
+      double f2=c.iy_z(ip,k2)+a2[0]*d(ip,k2)+a2[1]*d(ip,k2+1)+
+	a2[2]*c.zyy(ip,k2)+a2[3]*c.zyy(ip,k2+1);
+      double g1=c.iy_zxx(ip,k1)+a1[0]*c.zxx(ip,k1)+a1[1]*c.zxx(ip,k1+1)+
+	a1[2]*c.zxxyy(ip,k1)+a1[3]*c.zxxyy(ip,k1+1);
+      double g2=c.iy_zxx(ip,k2)+a2[0]*c.zxx(ip,k2)+a2[1]*c.zxx(ip,k2+1)+
+	a2[2]*c.zxxyy(ip,k2)+a2[3]*c.zxxyy(ip,k2+1);
+      result+=wx[p]*(f2-f1)+wx[p+2]*(g2-g1);
+    }
+    return result;
+  }
   
   interp_vec<ubvector,ubmatrix_column> itp;
 
@@ -1021,6 +1290,15 @@ double table3d::deriv_xy(double x, double y, std::string name) const {
   double result;
   
   size_t z=lookup_slice(name);
+
+  if (cache_usable()) {
+    const slice_cache &c=cache_get(z);
+    size_t i, j;
+    double wx[4], wy[4];
+    cache_weights(xval,icache_svx,x,i,wx,true);
+    cache_weights(yval,icache_svy,y,j,wy,true);
+    return cache_eval(z,c,i,j,wx,wy);
+  }
   
   interp_vec<ubvector,ubmatrix_column> itp;
 
@@ -1045,6 +1323,7 @@ void table3d::zero_table() {
       }
     }
   }
+  clear_interp_cache();
   return;
 }
 
@@ -1057,6 +1336,7 @@ void table3d::clear() {
   has_slice=false;
   xy_set=false;
   size_set=false;
+  clear_interp_cache();
   return;
 }
 
@@ -1066,6 +1346,7 @@ void table3d::clear_data() {
     list[i].clear();
   }
   list.clear();
+  icache.clear();
       
   has_slice=false;
   return;
@@ -1258,10 +1539,12 @@ const boost::numeric::ublas::matrix<double> &table3d::get_slice
 boost::numeric::ublas::matrix<double> &table3d::get_slice
 (std::string name) {
   size_t z=lookup_slice(name);
+  cache_invalidate(z);
   return list[z];
 }
 
 boost::numeric::ublas::matrix<double> &table3d::get_slice(size_t iz) {
+  cache_invalidate(iz);
   return list[iz];
 }
 
@@ -1275,6 +1558,7 @@ void table3d::function_slice(string function, string scol) {
   size_t ic=lookup_slice(scol);
 
   function_matrix(function,list[ic]);
+  cache_invalidate(ic);
 
   return;
 }
@@ -33,6 +33,7 @@
 #include <string>
 #include <cmath>
 #include <sstream>
+#include <mutex>
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/vector_proxy.hpp>
@@ -68,8 +69,20 @@ namespace o2scl {
   /** \brief A data structure containing one or more slices of
       two-dimensional data points defined on a grid
 
-      \future Improve interpolation and derivative caching, possibly
-      through non-const versions of the interpolation functions.
+      For linear and cubic spline interpolation (natural or
+      periodic), the first call to \ref interp(), \ref deriv_x(),
+      \ref deriv_y(), \ref deriv_xy(), \ref integ_x() or \ref
+      integ_y() for a slice computes the tensor-product spline
+      coefficients for the entire slice and stores them. Subsequent
+      calls require only two binary searches and a small fixed
+      number of multiplications. The cache is discarded by all of
+      the member functions which modify the grid or the data, but
+      it is not aware of modifications made through a reference
+      (e.g. one obtained from \ref get_slice()) after the
+      corresponding interpolation call. Use \ref clear_interp_cache()
+      in that case. Other interpolation types refit one-dimensional
+      interpolators for every call.
+
       \future Should there be a clear_grid() function separate from
       clear_data() and clear()?
       \future Allow the user to more clearly probe 'size_set' vs.
@@ -139,6 +152,7 @@ namespace o2scl {
       for(size_t i=0;i<ny;i++) (yval)[i]=y[i];
       size_set=true;
       xy_set=true;
+      clear_interp_cache();
       return;
     }
 
@@ -252,6 +266,7 @@ namespace o2scl {
       for(size_t i=0;i<nv && i<list.size();i++) {
 	list[i](ix,iy)=vals[i];
       }
+      clear_interp_cache();
       return;
     }
     
@@ -333,6 +348,7 @@ namespace o2scl {
       for(size_t i=0;i<nv && i<list.size();i++) {
 	list[i](ix,iy)=vals[i];
       }
+      clear_interp_cache();
       return;
     }
 
@@ -527,6 +543,15 @@ namespace o2scl {
     /** \brief Get the interpolation type
      */
     size_t get_interp_type() const;
+
+    /** \brief Discard the cached interpolation coefficients for
+	all slices
+
+	This is only needed when slice data has been modified
+	through a reference obtained before the most recent
+	interpolation call.
+    */
+    void clear_interp_cache();
     
     /** \brief Interpolate \c x and \c y in slice named \c name
      */
@@ -1018,6 +1043,97 @@ namespace o2scl {
     /// The interpolation type
     size_t itype;
     //@}
+
+    /// \name Interpolation cache
+    //@{
+    /** \brief Tensor-product spline data for one slice
+
+	Within each grid cell the interpolant is a product of
+	one-dimensional cubic splines, determined by the data and its
+	second derivatives at the four corners. The cumulative
+	integrals allow \ref integ_x() and \ref integ_y() to avoid a
+	sum over the intervening cells.
+    */
+    class slice_cache {
+      
+    public:
+      
+      /// True if the coefficients are current
+      bool valid;
+      /// Second derivative with respect to x at the grid points
+      ubmatrix zxx;
+      /// Second derivative with respect to y at the grid points
+      ubmatrix zyy;
+      /// Mixed fourth derivative at the grid points
+      ubmatrix zxxyy;
+      /// Integral of the slice in x from the first grid point
+      ubmatrix ix_z;
+      /// Integral of \c zyy in x from the first grid point
+      ubmatrix ix_zyy;
+      /// Integral of the slice in y from the first grid point
+      ubmatrix iy_z;
+      /// Integral of \c zxx in y from the first grid point
+      ubmatrix iy_zxx;
+
+      slice_cache() {
+	valid=false;
+      }
+    };
+
+    /// The cache for each slice (same size as \ref list)
+    mutable std::vector<slice_cache> icache;
+    
+    /// True if \ref icache_svx and \ref icache_svy are current
+    mutable bool icache_grid;
+    
+    /// Search object for the x grid
+    mutable search_vec<const ubvector> icache_svx;
+    
+    /// Search object for the y grid
+    mutable search_vec<const ubvector> icache_svy;
+    
+    /// Lock for building the cache from const member functions
+    mutable std::mutex icache_mutex;
+
+    /** \brief Return true if the current interpolation type and
+	grid size can use the cache
+    */
+    bool cache_usable() const;
+
+    /// Mark the cache for slice \c z as out of date
+    void cache_invalidate(size_t z) {
+      if (z<icache.size()) icache[z].valid=false;
+      return;
+    }
+    
+    /** \brief Return the cache for slice \c z, computing it
+	if necessary
+    */
+    const slice_cache &cache_get(size_t z) const;
+
+    /** \brief Compute the cell index \c i for the point \c x0 
+	and the weights of the four spline coefficients in \c w
+
+	If \c deriv is true, the weights give the first derivative.
+    */
+    void cache_weights(const ubvector &grid,
+		       const search_vec<const ubvector> &sv, double x0,
+		       size_t &i, double w[4], bool deriv) const;
+
+    /** \brief Compute the cell index \c i for the point \c x0 
+	and the weights of the four spline coefficients for the 
+	integral from grid point \c i to \c x0
+    */
+    void cache_integ_weights(const ubvector &grid,
+			     const search_vec<const ubvector> &sv,
+			     double x0, size_t &i, double w[4]) const;
+
+    /** \brief Combine the coefficients for cell <tt>(i,j)</tt> of
+	slice \c z with the weights \c wx and \c wy
+    */
+    double cache_eval(size_t z, const slice_cache &c, size_t i, size_t j,
+		      const double wx[4], const double wy[4]) const;
+    //@}
   
     /// \name Tree iterator boundaries
     //@{
@@ -217,6 +217,71 @@ int main(void) {
     cout << endl;
   }
 
+  // Compare the cached interpolation with one-dimensional
+  // interpolation along the x grid followed by the y grid
+  for(size_t k=0;k<2;k++) {
+
+    size_t itp_type=(k==0) ? itp_cspline : itp_linear;
+    
+    table3d tc;
+    ubvector xg(7), yg(9);
+    for(size_t i=0;i<7;i++) xg[i]=((double)i)+0.1*sin((double)i);
+    for(size_t j=0;j<9;j++) yg[j]=0.5*((double)j)+0.2*j*j/9.0;
+    tc.set_xy("x",7,xg,"y",9,yg);
+    tc.new_slice("z");
+    for(size_t i=0;i<7;i++) {
+      for(size_t j=0;j<9;j++) {
+	tc.set(i,j,"z",sin(xg[i])*cos(yg[j])+xg[i]*yg[j]);
+      }
+    }
+    tc.set_interp_type(itp_type);
+    const ubmatrix &m=tc.get_slice("z");
+
+    for(double x=-0.5;x<7.0;x+=0.77) {
+      for(double y=-0.3;y<6.0;y+=0.61) {
+	
+	// Interpolate along x first, then along y
+	ubvector v(9), dv(9);
+	for(size_t j=0;j<9;j++) {
+	  ubvector col(7);
+	  for(size_t i=0;i<7;i++) col[i]=m(i,j);
+	  interp_vec<ubvector> ix(7,xg,col,itp_type);
+	  v[j]=ix.eval(x);
+	  dv[j]=ix.deriv(x);
+	}
+	interp_vec<ubvector> iy(9,yg,v,itp_type);
+	interp_vec<ubvector> idy(9,yg,dv,itp_type);
+	
+	t.test_rel(tc.interp(x,y,"z"),iy.eval(y),1.0e-12,"cache interp");
+	t.test_rel(tc.deriv_x(x,y,"z"),idy.eval(y),1.0e-10,"cache deriv_x");
+	t.test_rel(tc.deriv_y(x,y,"z"),iy.deriv(y),1.0e-10,"cache deriv_y");
+	t.test_rel(tc.deriv_xy(x,y,"z"),idy.deriv(y),1.0e-10,
+		   "cache deriv_xy");
+	t.test_rel(tc.integ_y(x,0.3,y,"z"),iy.integ(0.3,y),1.0e-10,
+		   "cache integ_y");
+	
+	// Interpolate along y first for the integral in x
+	ubvector w(7);
+	for(size_t i=0;i<7;i++) {
+	  ubvector row(9);
+	  for(size_t j=0;j<9;j++) row[j]=m(i,j);
+	  interp_vec<ubvector> iry(9,yg,row,itp_type);
+	  w[i]=iry.eval(y);
+	}
+	interp_vec<ubvector> iwx(7,xg,w,itp_type);
+	t.test_rel(tc.integ_x(x,1.2,y,"z"),iwx.integ(x,1.2),1.0e-10,
+		   "cache integ_x");
+      }
+    }
+
+    // Modifying the slice must discard the cache
+    double z0=tc.interp(2.5,1.5,"z");
+    tc.set(3,3,"z",tc.get(3,3,"z")+1.0);
+    t.test_gen(fabs(tc.interp(2.5,1.5,"z")-z0)>1.0e-3,"cache invalidate");
+    tc.get_slice("z")(3,3)-=1.0;
+    t.test_rel(tc.interp(2.5,1.5,"z"),z0,1.0e-12,"cache invalidate 2");
+  }
+
   /*
     12/4/15: This was old code for testing gen3_list. It just
     needs to be rewritten not to depend on separate text
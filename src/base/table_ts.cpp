@@ -86,6 +86,28 @@ int main(void) {
       cout << ii << " " << tnam << " " << tval << endl;
     }
   
+    // -------------------------------------------------------------
+    // Test functions over several blocks of rows
+
+    table<> at3;
+    at3.line_of_names("x y");
+    for(size_t ii=0;ii<1000;ii++) {
+      double line[2]={((double)ii)/100.0,sin(((double)ii)/50.0)};
+      at3.line_of_data(2,line);
+    }
+    at3.add_constant("hc",197.33);
+    at3.function_column("hc*exp(-x)+y^2-(x>y)","z");
+    at3.functions_columns("w=abs(z-y) v=sqrt(x)*2");
+    for(size_t ii=0;ii<at3.get_nlines();ii+=37) {
+      double x=at3.get("x",ii), y=at3.get("y",ii);
+      double z=197.33*exp(-x)+y*y-(x>y);
+      t.test_rel(at3.get("z",ii),z,1.0e-14,"function_column");
+      t.test_rel(at3.get("w",ii),fabs(z-y),1.0e-14,"functions_columns");
+      t.test_rel(at3.get("v",ii),sqrt(x)*2.0,1.0e-14,"functions_columns 2");
+    }
+    t.test_gen(at3.row_function("x+y",10)==at3.get("x",10)+at3.get("y",10),
+	       "row_function");
+
     // -------------------------------------------------------------
     // Test copy constructors
 
@@ -199,6 +221,105 @@ int main(void) {
 
   }
 
+  {
+    // Interpolation cache with several pairs of columns
+    table<> ti;
+    ti.line_of_names("x y z");
+    for(size_t i=0;i<20;i++) {
+      double x=((double)i)/4.0;
+      double line[3]={x,x*x,sin(x)};
+      ti.line_of_data(3,line);
+    }
+    const vector<double> &cx=ti.get_column("x");
+    interp_vec<vector<double> > ity(20,cx,ti.get_column("y"));
+    interp_vec<vector<double> > itz(20,cx,ti.get_column("z"));
+    for(size_t k=0;k<3;k++) {
+      t.test_rel(ti.interp("x",1.3,"y"),ity.eval(1.3),1.0e-12,"cache y");
+      t.test_rel(ti.interp("x",1.3,"z"),itz.eval(1.3),1.0e-12,"cache z");
+      t.test_rel(ti.deriv_const("x",1.3,"z"),itz.deriv(1.3),1.0e-12,
+		 "cache deriv");
+      t.test_rel(ti.deriv2("x",1.3,"y"),ity.deriv2(1.3),1.0e-12,
+		 "cache deriv2");
+      t.test_rel(ti.integ_const("x",0.2,3.1,"z"),itz.integ(0.2,3.1),
+		 1.0e-12,"cache integ");
+    }
+
+    // Modifying a column must discard its interpolation objects
+    double y0=ti.interp("x",1.3,"y");
+    ti.set("y",5,ti.get("y",5)+1.0);
+    t.test_gen(fabs(ti.interp("x",1.3,"y")-y0)>1.0e-3,"cache reset");
+    t.test_rel(ti.interp("x",1.3,"z"),itz.eval(1.3),1.0e-12,
+	       "cache reset 2");
+    
+    // Shared const interpolation from several threads
+    ti.set("y",5,ti.get("y",5)-1.0);
+    const table<> &tc=ti;
+    vector<double> res(100);
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+    for(int i=0;i<100;i++) {
+      double x=((double)i)/25.0;
+      if (i%2==0) {
+	res[i]=tc.interp_const("x",x,"y");
+      } else {
+	res[i]=tc.interp_const("x",x,"z");
+      }
+    }
+    for(size_t i=0;i<100;i++) {
+      double x=((double)i)/25.0;
+      if (i%2==0) {
+	t.test_rel(res[i],ity.eval(x),1.0e-12,"cache threads y");
+      } else {
+	t.test_rel(res[i],itz.eval(x),1.0e-12,"cache threads z");
+      }
+    }
+
+    // Each of these modifications must also discard the
+    // interpolation objects
+    auto check=[&](std::string sy, std::string msg) {
+      interp_vec<vector<double> > itc(ti.get_nlines(),ti.get_column("x"),
+				      ti.get_column(sy));
+      t.test_rel(tc.interp_const("x",1.3,sy),itc.eval(1.3),1.0e-12,msg);
+    };
+    
+    tc.interp_const("x",1.3,"y");
+    vector<double> row={ti.get("x",5),ti.get("y",5)+1.0,ti.get("z",5)};
+    ti.set_row(5,row);
+    check("y","set_row");
+    
+    tc.interp_const("x",1.3,"y");
+    vector<double> vy(ti.get_maxlines());
+    for(size_t i=0;i<ti.get_nlines();i++) vy[i]=2.0*ti.get("y",i);
+    ti.swap_column_data("y",vy);
+    check("y","swap_column_data");
+
+    ti.copy_column("z","w");
+    tc.interp_const("x",1.3,"w");
+    ti.copy_column("y","w");
+    check("w","copy_column");
+
+    tc.interp_const("x",1.3,"z");
+    ti.inc_maxlines(100);
+    check("z","inc_maxlines");
+
+    tc.interp_const("x",1.3,"z");
+    ti.set_maxlines(300);
+    check("z","set_maxlines");
+
+    // Recompute an existing column with deriv(), deriv2() and integ()
+    ti.deriv("x","y","dy");
+    tc.interp_const("x",1.3,"dy");
+    ti.deriv("x","z","dy");
+    check("dy","deriv");
+    tc.interp_const("x",1.3,"dy");
+    ti.deriv2("x","z","dy");
+    check("dy","deriv2");
+    tc.interp_const("x",1.3,"dy");
+    ti.integ("x","y","dy");
+    check("dy","integ");
+  }
+
   t.report();
 
   return 0;
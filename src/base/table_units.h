@@ -139,7 +139,6 @@ namespace o2scl {
     
       }
 
-      this->intp_set=false;
       cup=&o2scl_settings.get_convert_units();
 
       this->is_valid();
@@ -181,7 +180,6 @@ namespace o2scl {
     
       }
 
-      this->intp_set=false;
       cup=&o2scl_settings.get_convert_units();
 
       this->is_valid();
@@ -231,10 +229,7 @@ namespace o2scl {
     
 	}
 
-	if (this->intp_set) {
-	  this->intp_set=false;
-	  delete this->si;
-	}
+	this->reset_interp();
 
 	cup=&o2scl_settings.get_convert_units();
 
@@ -283,10 +278,7 @@ namespace o2scl {
     
 	}
 
-	if (this->intp_set) {
-	  this->intp_set=false;
-	  delete this->si;
-	}
+	this->reset_interp();
 
 	cup=&o2scl_settings.get_convert_units();
 
@@ -458,6 +450,7 @@ namespace o2scl {
       for(size_t i=0;i<this->get_nlines();i++) {
 	vec[i]*=conv;
       }
+      this->reset_interp(scol);
 
       // Set new unit entry
       it->second=unit;
@@ -502,10 +495,7 @@ namespace o2scl {
       utree.clear();
       this->alist.clear();
       this->nlines=0;
-      if (this->intp_set==true) {
-	delete this->si;
-	this->intp_set=false;
-      }
+      this->reset_interp();
       return;
     }
 
@@ -540,6 +530,8 @@ namespace o2scl {
       // Reset the list to reflect the proper iterators
       this->reset_list();
 
+      this->reset_interp(scol);
+
       return;
     }
 
@@ -647,6 +639,7 @@ namespace o2scl {
       for(size_t i=0;i<this->nlines;i++) {
 	itd->second.dat[i]=its->second.dat[i];
       }
+      this->reset_interp(dest);
       return;
     }
     
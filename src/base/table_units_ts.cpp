@@ -73,6 +73,16 @@ int main(void) {
   t.test_gen(at4.get_ncolumns()==at.get_ncolumns(),"cc 2");
   t.test_gen(at5.get_nlines()==at.get_nlines(),"cc 3");
   t.test_gen(at5.get_ncolumns()==at.get_ncolumns(),"cc 4");
+
+  // -------------------------------------------------------------
+  // Test that copy_column() discards the interpolation objects
+
+  at.copy_column("col1","col3");
+  at.interp_const("col1",2.0,"col3");
+  at.copy_column("col2","col3");
+  t.test_rel(at.interp_const("col1",2.0,"col3"),
+	     at.interp_const("col1",2.0,"col2"),1.0e-14,
+	     "copy_column() and interpolation");
   
   t.report();
 
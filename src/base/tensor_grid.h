@@ -32,6 +32,7 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <atomic>
 
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_ieee_utils.h>
@@ -164,6 +165,11 @@ namespace o2scl {
     public tensor<double,vec_t,vec_size_t> {
     
   public:
+
+    /** \brief The maximum rank for which \ref interp_linear() 
+	uses only stack storage and search hints
+    */
+    static const size_t interp_max_rank=16;
   
 #ifndef DOXYGEN_INTERNAL
   
@@ -181,6 +187,31 @@ namespace o2scl {
 
     /// Interpolation type
     size_t itype;
+
+    /** \brief Spacing of the grid for each index, either 
+	\c grid_general, \c grid_uniform, or \c grid_log
+    */
+    std::vector<int> grid_spacing;
+
+    /** \brief The first grid point (or its logarithm) for each
+	index with a uniform or logarithmic grid
+    */
+    std::vector<double> grid_first;
+
+    /** \brief The inverse of the grid spacing (or the spacing in
+	the logarithm) for each index with a uniform or logarithmic
+	grid
+    */
+    std::vector<double> grid_inv_step;
+
+    /** \brief The most recent interval found in each index by
+	\ref interp_linear()
+
+	These are atomic so that concurrent calls to the const
+	interpolation functions from several threads remain safe. A
+	stale value only makes the next search slower.
+    */
+    mutable std::atomic<size_t> search_hint[interp_max_rank];
     
 #endif
     
@@ -192,6 +223,7 @@ namespace o2scl {
   tensor_grid() : tensor<double,vec_t,vec_size_t>() {
       grid_set=false;
       itype=itp_linear;
+      reset_search_hints();
     }
     
     /** \brief Create a tensor of rank \c rank with sizes given in \c dim
@@ -205,6 +237,7 @@ namespace o2scl {
     tensor<double,vec_t,vec_size_t>(rank,dim) {
       grid_set=false;
       itype=itp_linear;
+      reset_search_hints();
       // Note that the parent method sets rk to be equal to rank
       for(size_t i=0;i<this->rk;i++) {
 	if (dim[i]==0) {
@@ -223,6 +256,7 @@ namespace o2scl {
     tensor<double,vec_t,vec_size_t>() {    
       this->rk=ugs.size();
       itype=itp_linear;
+      reset_search_hints();
       size_t tot=1;
       for(size_t j=0;j<this->rk;j++) {
 	this->size.push_back(ugs[j].get_npoints());
@@ -281,6 +315,10 @@ namespace o2scl {
       grid=t.grid;
       grid_set=t.grid_set;
       itype=t.itype;
+      grid_spacing=t.grid_spacing;
+      grid_first=t.grid_first;
+      grid_inv_step=t.grid_inv_step;
+      reset_search_hints();
     }
     
     /** \brief Copy using <tt>operator=()</tt>
@@ -294,6 +332,10 @@ namespace o2scl {
 	grid=t.grid;
 	grid_set=t.grid_set;
 	itype=t.itype;
+	grid_spacing=t.grid_spacing;
+	grid_first=t.grid_first;
+	grid_inv_step=t.grid_inv_step;
+	reset_search_hints();
       }
       return *this;
     }
@@ -438,6 +480,7 @@ namespace o2scl {
       // Reset the grid
       grid_set=false;
       grid.resize(0);
+      grid_spacing.clear();
       // If the new rank is zero, reset the data, otherwise,
       // update the size vector and reset the data vector
       if (rank==0) {
@@ -495,6 +538,7 @@ namespace o2scl {
 	grid[i]=grid_vec[i];
       }
       grid_set=true;
+      analyze_grid();
       return;
     }
 
@@ -517,6 +561,7 @@ namespace o2scl {
 	}
       }
       grid_set=true;
+      analyze_grid();
       return;
     }
 
@@ -534,6 +579,7 @@ namespace o2scl {
 	}
       }
       grid_set=true;
+      analyze_grid();
       return;
     }
     
@@ -558,6 +604,7 @@ namespace o2scl {
 	  k++;
 	}
       }
+      analyze_grid();
       return;
     }
 
@@ -588,6 +635,7 @@ namespace o2scl {
 	  k++;
 	}
       }
+      analyze_grid();
       
       return;
     }
@@ -612,6 +660,7 @@ namespace o2scl {
 	}
       }
       grid_set=true;
+      analyze_grid();
       return;
     }
 
@@ -662,6 +711,8 @@ namespace o2scl {
       size_t istart=0;
       for(size_t k=0;k<i;k++) istart+=this->size[k];
       grid[istart+j]=val;
+      // The grid for this index may no longer be uniform
+      if (i<grid_spacing.size()) grid_spacing[i]=grid_general;
       return;
     }
 
@@ -1146,6 +1197,7 @@ namespace o2scl {
     void clear() {
       grid.resize(0);
       grid_set=false;
+      grid_spacing.clear();
       tensor<double,vec_t,vec_size_t>::clear();
       return;
     }
@@ -1349,59 +1401,139 @@ namespace o2scl {
 	function implied by the tensor and grid
 	
 	This performs multi-dimensional linear interpolation (or
-	extrapolation) It works by first using \ref o2scl::search_vec
-	to find the interval containing (or closest to) the specified
-	point in each direction and constructing the corresponding
-	hypercube of size \f$ 2^{\mathrm{rank}} \f$ containing \c v.
-	It then calls \ref interp_linear_power_two() to perform the
-	interpolation in that hypercube.
-
-	\future This starts with a small copy, which can be eliminated
-	by creating a new version of interp_linear_power_two
-	which accepts an offset vector parameter so that the 
-	first interpolation is offset. Remaining interpolations
-	don't need to be offset because the tensor has to be
-	created from the previous interpolation round.
+	extrapolation). It first uses a binary search to find the
+	interval containing (or closest to) the specified point in
+	each direction and then interpolates in the hypercube of
+	size \f$ 2^{\mathrm{rank}} \f$ containing \c v, working
+	directly on the packed grid and data. No memory is allocated
+	unless the rank is larger than \ref interp_max_rank.
+
+	The interval found in each index is stored and used as the
+	starting point for the next search, so that a sequence of
+	nearby points requires only a few comparisons per index.
+	For indices with uniform or logarithmic grids, the interval is
+	computed directly (see \ref lookup_interval()).
     */
-    template<class vec2_t> double interp_linear(vec2_t &v) const {
-
-      // Find the the corner of the hypercube containing v
-      size_t rgs=0;
-      std::vector<size_t> loc(this->rk);
-      std::vector<double> gnew;
-      for(size_t i=0;i<this->rk;i++) {
-	std::vector<double> grid_unpacked(this->size[i]);
-	for(size_t j=0;j<this->size[i];j++) {
-	  grid_unpacked[j]=grid[j+rgs];
-	}
-	search_vec<std::vector<double> > sv(this->size[i],grid_unpacked);
-	loc[i]=sv.find(v[i]);
-	gnew.push_back(grid_unpacked[loc[i]]);
-	gnew.push_back(grid_unpacked[loc[i]+1]);
-	rgs+=this->size[i];
+    template<class vec2_t> double interp_linear(const vec2_t &v) const {
+      
+      // Per-dimension strides in the data vector and interpolation
+      // fractions, stored on the stack in the common case
+      size_t stride_st[interp_max_rank];
+      double frac_st[interp_max_rank];
+      std::vector<size_t> stride_heap;
+      std::vector<double> frac_heap;
+      size_t *stride=stride_st;
+      double *frac=frac_st;
+      if (this->rk>interp_max_rank) {
+	stride_heap.resize(this->rk);
+	frac_heap.resize(this->rk);
+	stride=&stride_heap[0];
+	frac=&frac_heap[0];
       }
+      
+      size_t offset=interp_linear_setup(v,stride,frac,search_hint);
+      return interp_linear_corners(0,offset,stride,frac);
+    }
 
-      // Now construct a 2^{rk}-sized tensor containing only that 
-      // hypercube
-      std::vector<size_t> snew(this->rk);
-      for(size_t i=0;i<this->rk;i++) {
-	snew[i]=2;
+    /** \brief Perform linear interpolation for a set of \c n points
+
+	The points are stored in \c pts, with the \c rank coordinates
+	of the first point followed by those of the second point and
+	so on, so that \c pts must have at least <tt>n*rank</tt>
+	elements. The results are stored in the first \c n elements
+	of \c res. If <tt>O2SCL_OPENMP</tt> is defined, the points are
+	distributed among the OpenMP threads.
+    */
+    template<class vec2_t, class vec3_t>
+      void interp_linear_batch(size_t n, const vec2_t &pts,
+			       vec3_t &res) const {
+      
+      size_t rank=this->rk;
+      if (rank==0 || rank>interp_max_rank) {
+	O2SCL_ERR2("Rank zero or larger than interp_max_rank in ",
+		   "tensor_grid::interp_linear_batch().",
+		   o2scl::exc_einval);
       }
-      tensor_grid tnew(this->rk,snew);
-      tnew.set_grid_packed(gnew);
       
-      // Copy over the relevant data
-      for(size_t i=0;i<tnew.total_size();i++) {
-	std::vector<size_t> index_new(this->rk), index_old(this->rk);
-	tnew.unpack_index(i,index_new);
-	for(size_t j=0;j<this->rk;j++) index_old[j]=index_new[j]+loc[j];
-	tnew.set(index_new,this->get(index_old));
+#ifdef O2SCL_OPENMP
+#pragma omp parallel default(shared)
+#endif
+      {
+	// Each thread keeps its own search hints, so that nearby
+	// points in the same thread are found quickly
+	std::atomic<size_t> hint[interp_max_rank];
+	for(size_t i=0;i<rank;i++) {
+	  hint[i].store(search_hint[i].load(std::memory_order_relaxed),
+			std::memory_order_relaxed);
+	}
+	
+#ifdef O2SCL_OPENMP
+#pragma omp for
+#endif
+	for(size_t ip=0;ip<n;ip++) {
+	  size_t stride[interp_max_rank];
+	  double frac[interp_max_rank], v[interp_max_rank];
+	  for(size_t i=0;i<rank;i++) v[i]=pts[ip*rank+i];
+	  size_t offset=interp_linear_setup(v,stride,frac,hint);
+	  res[ip]=interp_linear_corners(0,offset,stride,frac);
+	}
       }
       
-      // Now use interp_power_two()
-      return tnew.interp_linear_power_two(v);
+      return;
     }
-    
+
+    /** \brief Compute the data indices and weights used by
+	\ref interp_linear() for the point \c v
+
+	This stores the \f$ 2^{\mathrm{rank}} \f$ indices (in the
+	packed data vector) of the corners of the hypercube
+	containing \c v in \c index and the corresponding linear
+	interpolation weights in \c weight, so that the result of
+	\ref interp_linear() is the sum of the data at each index
+	times the associated weight. The return value is the number
+	of corners. Both \c index and \c weight must have space for
+	at least \f$ 2^{\mathrm{rank}} \f$ elements.
+
+	This is useful when several tensors with the same grid are
+	to be interpolated at the same point, since the interval
+	search need only be performed once.
+    */
+    template<class vec2_t>
+      size_t interp_linear_stencil(const vec2_t &v, size_t *index,
+				   double *weight) const {
+
+      size_t rank=this->rk;
+      if (rank>interp_max_rank) {
+	O2SCL_ERR2("Rank larger than interp_max_rank in ",
+		   "tensor_grid::interp_linear_stencil().",
+		   o2scl::exc_einval);
+      }
+
+      size_t stride[interp_max_rank];
+      double frac[interp_max_rank];
+      size_t offset=interp_linear_setup(v,stride,frac,search_hint);
+
+      // Corner c has the upper value in index i if bit (rank-1-i)
+      // of c is set, so that the last index is innermost
+      size_t ncorners=((size_t)1) << rank;
+      for(size_t c=0;c<ncorners;c++) {
+	size_t ix=offset;
+	double w=1.0;
+	for(size_t i=0;i<rank;i++) {
+	  if ((c >> (rank-1-i)) & 1) {
+	    ix+=stride[i];
+	    w*=frac[i];
+	  } else {
+	    w*=1.0-frac[i];
+	  }
+	}
+	index[c]=ix;
+	weight[c]=w;
+      }
+
+      return ncorners;
+    }
+
     /** \brief Perform linear interpolation assuming that all
 	indices can take only two values
 
@@ -1445,6 +1577,254 @@ namespace o2scl {
       return tnew.interp_linear_power_two(v);
     }
 
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /** \brief Compute the data strides and the interpolation 
+	fractions for the point \c v, returning the index of the 
+	lower corner of the enclosing hypercube in the data vector
+	
+	The arrays \c stride and \c frac must have space for 
+	at least \c rank elements.
+    */
+    template<class vec2_t>
+      size_t interp_linear_setup(const vec2_t &v, size_t *stride,
+				 double *frac,
+				 std::atomic<size_t> *hint) const {
+      
+      if (!grid_set) {
+	O2SCL_ERR("Grid not set in tensor_grid::interp_linear().",
+		  exc_einval);
+      }
+      
+      if (this->rk==0) {
+	O2SCL_ERR("Rank zero in tensor_grid::interp_linear().",
+		  exc_einval);
+      }
+      
+      size_t offset=0, gstart=0, str=this->total_size();
+      for(size_t i=0;i<this->rk;i++) {
+
+	size_t n=this->size[i];
+	if (n<2) {
+	  O2SCL_ERR2("Grid size less than two in ",
+		     "tensor_grid::interp_linear().",exc_einval);
+	}
+	str/=n;
+	stride[i]=str;
+	
+	// Find the interval containing v[i], which is always between
+	// 0 and n-2 inclusive so that extrapolation uses the first
+	// or last interval
+	size_t lo;
+	if (i<interp_max_rank) {
+	  lo=lookup_interval(i,gstart,v[i],
+			     hint[i].load(std::memory_order_relaxed));
+	  hint[i].store(lo,std::memory_order_relaxed);
+	} else {
+	  lo=lookup_interval(i,gstart,v[i],n/2);
+	}
+	lo+=gstart;
+	frac[i]=(v[i]-grid[lo])/(grid[lo+1]-grid[lo]);
+	offset+=(lo-gstart)*str;
+	gstart+=n;
+      }
+      
+      return offset;
+    }
+
+    /** \brief Recursively interpolate in the hypercube with lower
+	corner at \c offset, beginning with index \c i
+    */
+    double interp_linear_corners(size_t i, size_t offset,
+				 const size_t *stride,
+				 const double *frac) const {
+      if (i+1==this->rk) {
+	double lo=this->data[offset];
+	return lo+frac[i]*(this->data[offset+stride[i]]-lo);
+      }
+      double lo=interp_linear_corners(i+1,offset,stride,frac);
+      double hi=interp_linear_corners(i+1,offset+stride[i],stride,frac);
+      return lo+frac[i]*(hi-lo);
+    }
+
+    /// \name Grid spacing types for \ref grid_spacing
+    //@{
+    static const int grid_general=0;
+    static const int grid_uniform=1;
+    static const int grid_log=2;
+    //@}
+
+    /// Set all of the search hints to zero
+    void reset_search_hints() {
+      for(size_t i=0;i<interp_max_rank;i++) {
+	search_hint[i].store(0,std::memory_order_relaxed);
+      }
+      return;
+    }
+    
+    /** \brief Determine which indices have uniform or logarithmic
+	grids, as created by \ref o2scl::uniform_grid, so that
+	\ref lookup_interval() can compute the interval directly
+
+	This is called by the functions which set the grid. A grid
+	is considered uniform (logarithmic) if every point (the
+	logarithm of every point) is within \f$ 10^{-10} \f$ of the
+	spacing from the value implied by the first and last points.
+    */
+    void analyze_grid() {
+      
+      grid_spacing.resize(this->rk);
+      grid_first.resize(this->rk);
+      grid_inv_step.resize(this->rk);
+      
+      size_t gstart=0;
+      for(size_t i=0;i<this->rk;i++) {
+	
+	size_t n=this->size[i];
+	grid_spacing[i]=grid_general;
+	
+	if (n>=3) {
+	  
+	  // Check for a uniform grid
+	  double first=grid[gstart];
+	  double step=(grid[gstart+n-1]-first)/((double)(n-1));
+	  bool uniform=(step!=0.0 && std::isfinite(step));
+	  for(size_t j=1;uniform && j<n-1;j++) {
+	    if (fabs(grid[gstart+j]-first-step*j)>1.0e-10*fabs(step)) {
+	      uniform=false;
+	    }
+	  }
+	  if (uniform) {
+	    grid_spacing[i]=grid_uniform;
+	    grid_first[i]=first;
+	    grid_inv_step[i]=1.0/step;
+	  } else if (first!=0.0 && grid[gstart+n-1]/first>0.0) {
+	    
+	    // Check for a logarithmic grid
+	    double lfirst=log(fabs(first));
+	    double lstep=(log(fabs(grid[gstart+n-1]))-lfirst)/
+	      ((double)(n-1));
+	    bool logarithmic=(lstep!=0.0 && std::isfinite(lstep));
+	    for(size_t j=1;logarithmic && j<n-1;j++) {
+	      if (grid[gstart+j]/first<=0.0 ||
+		  fabs(log(fabs(grid[gstart+j]))-lfirst-lstep*j)>
+		  1.0e-10*fabs(lstep)) {
+		logarithmic=false;
+	      }
+	    }
+	    if (logarithmic) {
+	      grid_spacing[i]=grid_log;
+	      grid_first[i]=lfirst;
+	      grid_inv_step[i]=1.0/lstep;
+	    }
+	  }
+	}
+	
+	gstart+=this->size[i];
+      }
+      
+      return;
+    }
+
+    /** \brief Return true if \c lo is the interval for \c x in
+	the grid for an index of size \c n beginning at \c gstart
+
+	This matches the conventions of \ref vector_bsearch_inc() 
+	and \ref vector_bsearch_dec(), so that the first and last
+	intervals are used for points outside the grid.
+    */
+    bool is_interval(size_t gstart, size_t n, double x, size_t lo,
+		     bool inc) const {
+      if (inc) {
+	return (lo==0 || grid[gstart+lo]<=x) &&
+	  (lo+2==n || x<grid[gstart+lo+1]);
+      }
+      return (lo==0 || grid[gstart+lo]>=x) &&
+	(lo+2==n || x>grid[gstart+lo+1]);
+    }
+    
+    /** \brief Find the interval containing \c x for index \c i with
+	a grid beginning at \c gstart in the packed grid, using the
+	initial guess \c hint
+
+	For uniform and logarithmic grids, the interval is computed
+	directly and then verified against the grid. Otherwise, the
+	intervals adjacent to \c hint are checked first, and then
+	the search expands exponentially away from \c hint before
+	a binary search, so that points near the previous one are
+	found in a few comparisons. The return value is between 0
+	and <tt>n-2</tt> inclusive, where \c n is the size of
+	index \c i, and is identical to the result of a full binary
+	search with \ref vector_bsearch_inc() or \ref
+	vector_bsearch_dec().
+    */
+    size_t lookup_interval(size_t i, size_t gstart, double x,
+			   size_t hint) const {
+      
+      size_t n=this->size[i];
+      bool inc=(grid[gstart]<grid[gstart+n-1]);
+
+      if (i<grid_spacing.size() && grid_spacing[i]!=grid_general) {
+	double t;
+	if (grid_spacing[i]==grid_uniform) {
+	  t=(x-grid_first[i])*grid_inv_step[i];
+	} else {
+	  t=(log(fabs(x))-grid_first[i])*grid_inv_step[i];
+	}
+	if (t==t) {
+	  if (t<=0.0) {
+	    hint=0;
+	  } else if (t>=((double)(n-2))) {
+	    hint=n-2;
+	  } else {
+	    hint=(size_t)t;
+	  }
+	}
+      }
+      if (hint>n-2) hint=n/2-1;
+      
+      // Check the hint and its neighbors
+      if (is_interval(gstart,n,x,hint,inc)) return hint;
+      if (hint+2<n && is_interval(gstart,n,x,hint+1,inc)) return hint+1;
+      if (hint>0 && is_interval(gstart,n,x,hint-1,inc)) return hint-1;
+
+      // Expand away from the hint until x is bracketed
+      size_t lo, hi;
+      if (inc ? x>=grid[gstart+hint] : x<=grid[gstart+hint]) {
+	lo=hint;
+	size_t step=2;
+	hi=hint+step;
+	if (hi>n-1) hi=n-1;
+	while (hi<n-1 && (inc ? x>=grid[gstart+hi] : x<=grid[gstart+hi])) {
+	  lo=hi;
+	  step*=2;
+	  hi=(lo+step>n-1) ? n-1 : lo+step;
+	}
+      } else {
+	hi=hint+1;
+	size_t step=2;
+	lo=(hint>step) ? hint-step : 0;
+	while (lo>0 && (inc ? x<grid[gstart+lo] : x>grid[gstart+lo])) {
+	  hi=lo;
+	  step*=2;
+	  lo=(hi>step) ? hi-step : 0;
+	}
+      }
+      
+      if (inc) {
+	return vector_bsearch_inc<vec_t,double>
+	  (x,grid,gstart+lo,gstart+hi)-gstart;
+      }
+      return vector_bsearch_dec<vec_t,double>
+	(x,grid,gstart+lo,gstart+hi)-gstart;
+    }
+
+  public:
+    
+#endif
+
     /** \brief Perform a linear interpolation of <tt>v[1]</tt>
 	to <tt>v[n-1]</tt> resulting in a vector
 
@@ -203,6 +203,93 @@ int main(void) {
       t.test_rel(res3[2],res2,1.0e-12,"interp_linear_vec 10");
     }
 
+    // Compare with interp_linear_partial() for points inside and
+    // outside the grid, and with interp_linear_batch()
+    std::vector<size_t> ix_all(3), ix_tmp(3);
+    ix_all[0]=0;
+    ix_all[1]=1;
+    ix_all[2]=2;
+    std::vector<double> pts, bres(5);
+    for(size_t k=0;k<5;k++) {
+      v[0]=0.5+0.8*k;
+      v[1]=1.1+0.4*k;
+      v[2]=3.4-0.6*k;
+      for(size_t j=0;j<3;j++) pts.push_back(v[j]);
+      t.test_rel(m3.interp_linear(v),
+		 m3.interp_linear_partial(ix_all,ix_tmp,v),
+		 1.0e-12,"interp_linear vs. partial");
+    }
+    m3.interp_linear_batch(5,pts,bres);
+    for(size_t k=0;k<5;k++) {
+      for(size_t j=0;j<3;j++) v[j]=pts[k*3+j];
+      t.test_rel(bres[k],m3.interp_linear(v),1.0e-14,
+		 "interp_linear_batch");
+    }
+
+    // Test interp_linear_stencil()
+    for(size_t k=0;k<5;k++) {
+      for(size_t j=0;j<3;j++) v[j]=pts[k*3+j];
+      size_t sindex[8];
+      double sweight[8], ssum=0.0;
+      size_t nc=m3.interp_linear_stencil(v,sindex,sweight);
+      t.test_gen(nc==8,"interp_linear_stencil size");
+      for(size_t c=0;c<nc;c++) {
+	ssum+=sweight[c]*m3.get_data()[sindex[c]];
+      }
+      t.test_rel(ssum,m3.interp_linear(v),1.0e-12,
+		 "interp_linear_stencil");
+    }
+
+  }
+
+  // -------------------------------------------------------
+  // Test interval lookup for uniform, logarithmic and 
+  // irregular grids
+
+  {
+    tensor_grid<> tg;
+    size_t sz[3]={11,21,7};
+    tg.resize(3,sz);
+    std::vector<double> grid;
+    for(size_t i=0;i<11;i++) grid.push_back(-1.0+0.2*i);
+    for(size_t i=0;i<21;i++) grid.push_back(1.0e-3*pow(10.0,i*0.2));
+    for(size_t i=0;i<7;i++) grid.push_back(5.0-((double)(i*i))/4.0);
+    tg.set_grid_packed(grid);
+    for(size_t i=0;i<11;i++) {
+      for(size_t j=0;j<21;j++) {
+	for(size_t k=0;k<7;k++) {
+	  size_t ix[3]={i,j,k};
+	  tg.set(ix,sin(tg.get_grid(0,i))+log(tg.get_grid(1,j))*
+		 tg.get_grid(2,k));
+	}
+      }
+    }
+    
+    std::vector<size_t> ix_all(3), ix_tmp(3);
+    ix_all[0]=0;
+    ix_all[1]=1;
+    ix_all[2]=2;
+    std::vector<double> v(3);
+    for(size_t k=0;k<200;k++) {
+      // Move slowly, jump occasionally, and go off the grid
+      double t2=((double)k)/10.0;
+      if (k%37==0) t2*=-3.0;
+      v[0]=-1.3+0.013*k+0.001*sin(t2);
+      v[1]=5.0e-4*pow(10.0,t2/4.0);
+      v[2]=5.5-0.05*k*cos(t2);
+      t.test_rel(tg.interp_linear(v),
+		 tg.interp_linear_partial(ix_all,ix_tmp,v),
+		 1.0e-12,"lookup_interval");
+    }
+    // Grid points exactly
+    for(size_t k=0;k<21;k++) {
+      v[0]=tg.get_grid(0,k%11);
+      v[1]=tg.get_grid(1,k);
+      v[2]=tg.get_grid(2,k%7);
+      t.test_rel(tg.interp_linear(v),
+		 tg.interp_linear_partial(ix_all,ix_tmp,v),
+		 1.0e-12,"lookup_interval 2");
+    }
   }
 
   // -------------------------------------------------------
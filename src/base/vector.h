@@ -48,6 +48,7 @@
 #include <iostream>
 #include <cmath>
 #include <string>
+#include <array>
 #include <fstream>
 #include <sstream>
 
@@ -109,6 +110,34 @@ namespace o2scl {
     }
   };
 
+  /// \name Resizing vectors in src/base/vector.h
+  //@{
+  /** \brief Resize vector \c v to hold \c n elements
+
+      This generic version calls <tt>resize()</tt> and is
+      specialized below for fixed-size vectors.
+  */
+  template<class vec_t> void vector_resize(vec_t &v, size_t n) {
+    v.resize(n);
+    return;
+  }
+
+  /** \brief Resize a <tt>std::array</tt> object
+
+      Since the size of a <tt>std::array</tt> is fixed, this
+      function does nothing unless \c n is larger than \c N, in
+      which case the error handler is called.
+  */
+  template<class data_t, size_t N>
+    void vector_resize(std::array<data_t,N> &v, size_t n) {
+    if (n>N) {
+      O2SCL_ERR2("Requested size larger than array size in ",
+		 "vector_resize().",exc_einval);
+    }
+    return;
+  }
+  //@}
+
   /// \name Copying vectors and matrices in src/base/vector.h
   //@{
   /** \brief Simple vector copy
@@ -364,6 +364,7 @@ namespace o2scl {
       pts=e.pts;
       vals_ix=e.vals_ix;
     }
+    return *this;
   }
       
   /** \brief The dimensionality */
@@ -423,12 +424,12 @@ namespace o2scl {
       /* nothing to evaluate */
       return o2scl::success;
     }
-    if (r.dim==1) {
-      if (rule15gauss_evalError(r, R[0].fdim, f, nR, R)) {
+    if (n_threads>1 && nR>1) {
+      if (eval_regions_para(nR, R, f, r)) {
 	return o2scl::gsl_failure;
       }
     } else {
-      if (rule75genzmalik_evalError(r, R[0].fdim, f, nR, R)) {
+      if (eval_rule(r, R[0].fdim, f, nR, &(R[0]))) {
 	return o2scl::gsl_failure;
       }
     }
@@ -438,6 +439,66 @@ namespace o2scl {
     return o2scl::success;
   }
 
+  /** \brief Evaluate the rule \c r on the \c nR regions 
+      starting at \c R
+  */
+  int eval_rule(rule &r, size_t fdim, func_t &f, size_t nR, region *R) {
+    if (r.dim==1) {
+      return rule15gauss_evalError(r, fdim, f, nR, R);
+    }
+    return rule75genzmalik_evalError(r, fdim, f, nR, R);
+  }
+
+  /** \brief Evaluate the \c nR regions in \c R, dividing them
+      among \ref n_threads threads
+
+      Each thread uses its own copy of the rule from \ref rule_thr
+      or \ref rule75_thr, so that the point and value buffers are
+      not shared.
+  */
+  int eval_regions_para(size_t nR, std::vector<region> &R, func_t &f,
+			rule &r) {
+    
+    size_t n_chunk=n_threads;
+    if (n_chunk>nR) n_chunk=nR;
+    size_t fdim=R[0].fdim;
+    
+#ifdef O2SCL_OPENMP
+
+    std::vector<int> rets(n_chunk,0);
+    o2scl::err_para_store eps(n_chunk);
+    
+#pragma omp parallel for default(shared) num_threads(n_chunk) schedule(static)
+    for(size_t ic=0;ic<n_chunk;ic++) {
+      size_t i0=ic*nR/n_chunk;
+      size_t i1=(ic+1)*nR/n_chunk;
+      rule &rt=((r.dim==1) ? rule_thr[ic] : ((rule &)rule75_thr[ic]));
+      eps.run(ic,[&]() {
+	  rets[ic]=eval_rule(rt, fdim, f, i1-i0, &(R[i0]));
+	});
+    }
+    // End of parallel region
+
+    eps.rethrow();
+    for(size_t ic=0;ic<n_chunk;ic++) {
+      if (rets[ic]!=0) return o2scl::gsl_failure;
+    }
+    
+#else
+
+    for(size_t ic=0;ic<n_chunk;ic++) {
+      size_t i0=ic*nR/n_chunk;
+      size_t i1=(ic+1)*nR/n_chunk;
+      if (eval_rule(r, fdim, f, i1-i0, &(R[i0]))) {
+	return o2scl::gsl_failure;
+      }
+    }
+
+#endif
+    
+    return o2scl::success;
+  }
+
   /** \brief Functions to loop over points in a hypercube.
     
       Based on orbitrule.cpp in HIntLib-0.0.10
@@ -641,6 +702,7 @@ namespace o2scl {
       weightE1=e.weightE1;
       weightE3=e.weightE3;
     }
+    return *this;
   }
 
   /** \brief Desc */
@@ -665,8 +727,7 @@ namespace o2scl {
     /** \brief Desc
      */
     int rule75genzmalik_evalError
-      (rule &runder, size_t fdim, func_t &f, size_t nR,
-       std::vector<region> &R) {
+      (rule &runder, size_t fdim, func_t &f, size_t nR, region *R) {
     
       /* lambda2 = sqrt(9/70), lambda4 = sqrt(9/10), lambda5 = sqrt(9/19) */
       const double lambda2 = 0.3585685828003180919906451539079374954541;
@@ -841,11 +902,19 @@ namespace o2scl {
       return;
     }
 
+    /** \brief Copies of a one-dimensional rule for each thread
+     */
+    std::vector<rule> rule_thr;
+
+    /** \brief Copies of a multi-dimensional rule for each thread
+     */
+    std::vector<rule75genzmalik> rule75_thr;
+
     /** \brief 1d 15-point Gaussian quadrature rule, based on qk15.c
 	and qk.c in GNU GSL (which in turn is based on QUADPACK).
     */
     int rule15gauss_evalError
-      (rule &r, size_t fdim, func_t &f, size_t nR, std::vector<region> &R) {
+      (rule &r, size_t fdim, func_t &f, size_t nR, region *R) {
 
       static const double cub_dbl_min=std::numeric_limits<double>::min();
       static const double cub_dbl_eps=std::numeric_limits<double>::epsilon();
@@ -1285,6 +1354,15 @@ namespace o2scl {
       if (norm < 0 || norm > ERROR_LINF) return o2scl::gsl_failure; 
 
       regions = heap_alloc(1, fdim);
+
+      /* copies of the rule for each thread */
+      if (n_threads>1) {
+	if (r.dim==1) {
+	  rule_thr.assign(n_threads,r);
+	} else {
+	  rule75_thr.assign(n_threads,*((rule75genzmalik *)(&r)));
+	}
+      }
      
       nR_alloc = 2;
       R.resize(nR_alloc);
@@ -1303,7 +1381,7 @@ namespace o2scl {
 	}
 
 	/* maximize potential parallelism */
-	if (parallel) { 
+	if (parallel || n_threads>1) { 
 
 	  /* Adapted from I. Gladwell, "Vectorization of one
 	     dimensional quadrature codes," pp. 230--238 in _Numerical
@@ -1330,6 +1408,9 @@ namespace o2scl {
 	     better than the O(N) cost of the Bull and Freeman
 	     algorithm if K << N, and it is also much simpler.] 
 	  */
+	  /* When several threads are used, subdivide at least
+	     one region per thread, even if fewer regions are
+	     required to reach the requested tolerance */
 	  size_t nR = 0;
 	  for (j = 0; j < fdim; ++j) ee[j] = regions.ee[j];
 	  do {
@@ -1340,9 +1421,14 @@ namespace o2scl {
 	    }
 	    R[nR] = heap_pop(regions);
 	    for (j = 0; j < fdim; ++j) ee[j].err -= R[nR].ee[j].err;
+	    if (cut_region(R[nR], R[nR+1])) {
+	      heap_free(regions);
+	      return o2scl::gsl_failure;
+	    }
 	    numEval += r.num_points * 2;
 	    nR += 2;
-	    if (converged(fdim, ee, reqAbsError, reqRelError, norm)) {
+	    if (nR >= 2*n_threads &&
+		converged(fdim, ee, reqAbsError, reqRelError, norm)) {
 	      /* other regions have small errs */
 	      break; 
 	    }
@@ -1439,9 +1525,22 @@ namespace o2scl {
 
     /// Desc
     int use_parallel;
+
+    /** \brief Number of OpenMP threads (default 1)
+
+	If this is greater than one, then in each iteration at least
+	\c n_threads regions with the largest errors are subdivided,
+	and the new regions are divided among the threads. Each
+	thread calls the integrand with the points from its own
+	regions, so the integrand must be safe to call from several
+	threads at once. If OpenMP is not enabled, the regions are
+	still subdivided in this way but they are evaluated serially.
+    */
+    size_t n_threads;
     
     inte_hcubature() {
       use_parallel=0;
+      n_threads=1;
     }
 
     /** \brief Desc
@@ -1531,6 +1630,43 @@ namespace o2scl {
     vec_t val;
   };
 
+  /** \brief Evaluate the function at the \c npts points in \c x,
+      dividing the points among \ref n_threads threads
+  */
+  int eval_points(func_t &f, size_t dim, size_t npts, const double *x,
+		  size_t fdim, double *fx) {
+
+#ifdef O2SCL_OPENMP
+    
+    if (n_threads>1 && npts>1) {
+      
+      size_t n_chunk=n_threads;
+      if (n_chunk>npts) n_chunk=npts;
+      std::vector<int> rets(n_chunk,0);
+      o2scl::err_para_store eps(n_chunk);
+      
+#pragma omp parallel for default(shared) num_threads(n_chunk) schedule(static)
+      for(size_t ic=0;ic<n_chunk;ic++) {
+	size_t i0=ic*npts/n_chunk;
+	size_t i1=(ic+1)*npts/n_chunk;
+	eps.run(ic,[&]() {
+	    rets[ic]=f(dim, i1-i0, x+i0*dim, fdim, fx+i0*fdim);
+	  });
+      }
+      // End of parallel region
+      
+      eps.rethrow();
+      for(size_t ic=0;ic<n_chunk;ic++) {
+	if (rets[ic]!=0) return o2scl::gsl_failure;
+      }
+      return o2scl::success;
+    }
+    
+#endif
+    
+    return f(dim, npts, x, fdim, fx);
+  }
+
   /** \brief Desc
 
       recursive loop over all cubature points for the given (m,mi)
@@ -1554,7 +1690,7 @@ namespace o2scl {
 	  (((const vec_t &)buf),0,buf.size());
 	vec_range_t val2=o2scl::vector_range(val,vali,val.size());
 	/* flush buffer */
-	if (f(dim, nbuf, &(buf[0]), fdim, &(val[0]) + vali)) {
+	if (eval_points(f, dim, nbuf, &(buf[0]), fdim, &(val[0]) + vali)) {
 	  return o2scl::gsl_failure;
 	}
 	vali += ibuf * fdim;
@@ -1648,7 +1784,8 @@ namespace o2scl {
       const vec_crange_t buf2=o2scl::const_vector_range
 	(((const vec_t &)buf),0,buf.size());
       vec_range_t val2=o2scl::vector_range(vc[ic].val,vali,vc[ic].val.size());
-      return f(dim, ibuf, &(buf[0]), fdim, &((vc[ic].val)[vali]));
+      return eval_points(f, dim, ibuf, &(buf[0]), fdim,
+			 &((vc[ic].val)[vali]));
     }
 
     return o2scl::success;
@@ -1867,6 +2004,22 @@ namespace o2scl {
   }
     
   public:
+
+  /** \brief Number of OpenMP threads (default 1)
+
+      If this is greater than one, then each batch of points is
+      divided among the threads, and each thread calls the integrand
+      with its own portion of the batch. The integrand must be safe
+      to call from several threads at once. In \ref integ(), the
+      maximum batch size is also increased in proportion to the
+      number of threads. This value is ignored if OpenMP is not
+      enabled.
+  */
+  size_t n_threads;
+
+  inte_pcubature() {
+    n_threads=1;
+  }
     
   /** \brief Desc
 
@@ -1987,9 +2140,11 @@ namespace o2scl {
     vec_t buf;
 
     /* max_nbuf > 0 to amortize function overhead */
+    size_t max_nbuf=16;
+    if (n_threads>1) max_nbuf*=n_threads;
     ret = integ_v_buf(fdim,f,dim,xmin,xmax,
 		      maxEval,reqAbsError,reqRelError,norm,
-		      m,buf,nbuf,16,val,err);
+		      m,buf,nbuf,max_nbuf,val,err);
 
     return ret;
   }
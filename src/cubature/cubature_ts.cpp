@@ -55,6 +55,7 @@
 #include <boost/numeric/ublas/vector_proxy.hpp>
 
 #include <o2scl/test_mgr.h>
+#include <o2scl/exception.h>
 #include <o2scl/constants.h>
 #include <o2scl/vector.h>
 #include <o2scl/cubature.h>
@@ -575,6 +576,65 @@ int main(void) {
     tmgr.test_rel(1.569270,dres2[1],1.0e-6,"pc mdim val 1");
     tmgr.test_rel(1.056968,dres2[2],1.0e-6,"pc mdim val 2");
   }
+
+  // The same test using several threads. The integrand fv2() does
+  // not modify any global data, so it is safe to call from more than
+  // one thread.
+  
+  {
+    vector<double> vlow(2), vhigh(2);
+    ubvector vlow2(2), vhigh2(2);
+    vlow[0]=-2.0;
+    vlow[1]=-2.0;
+    vhigh[0]=2.0;
+    vhigh[1]=2.0;
+    vlow2[0]=-2.0;
+    vlow2[1]=-2.0;
+    vhigh2[0]=2.0;
+    vhigh2[1]=2.0;
+    vector<double> dres(3), derr(3);
+    ubvector dres2(3), derr2(3);
+    cub_funct_arr cfa2=fv2;
+    hc.n_threads=4;
+    pc.n_threads=4;
+    int ret=hc.integ(3,cfa2,2,vlow,vhigh,10000,0.0,1.0e-4,en,dres,derr);
+    tmgr.test_gen(ret==0,"hc threads ret");
+    tmgr.test_rel(3.067993,dres[0],1.0e-4,"hc threads val 0");
+    tmgr.test_rel(1.569270,dres[1],1.0e-4,"hc threads val 1");
+    tmgr.test_rel(1.056968,dres[2],1.0e-4,"hc threads val 2");
+    ret=pc.integ(3,cfa2,2,vlow2,vhigh2,10000,0.0,1.0e-4,en,dres2,derr2);
+    tmgr.test_gen(ret==0,"pc threads ret");
+    tmgr.test_rel(3.067993,dres2[0],1.0e-6,"pc threads val 0");
+    tmgr.test_rel(1.569270,dres2[1],1.0e-6,"pc threads val 1");
+    tmgr.test_rel(1.056968,dres2[2],1.0e-6,"pc threads val 2");
+
+    // One-dimensional integral with several threads
+    cub_funct_arr cfa_cos=[](size_t ndim, size_t npt, const double *x,
+			     size_t fdim, double *fval) {
+      for(size_t i=0;i<npt;i++) fval[i]=cos(x[i]);
+      return 0;
+    };
+    ubvector vval(1), verr(1);
+    ret=hc.integ(1,cfa_cos,1,xmin,xmax,0,0.0,1.0e-8,en,vval,verr);
+    tmgr.test_gen(ret==0,"hc threads 1d ret");
+    tmgr.test_rel(vval[0],sin(1.0),1.0e-8,"hc threads 1d val");
+
+    // An error in the integrand is rethrown with its original type
+    cub_funct_arr cfa_err=[](size_t ndim, size_t npt, const double *x,
+			     size_t fdim, double *fval) -> int {
+      O2SCL_ERR("Test error in integrand.",o2scl::exc_einval);
+      return 0;
+    };
+    bool caught=false;
+    try {
+      hc.integ(1,cfa_err,1,xmin,xmax,0,0.0,1.0e-8,en,vval,verr);
+    } catch (o2scl::exc_invalid_argument &e) {
+      caught=true;
+    }
+    tmgr.test_gen(caught,"hc threads error type");
+    hc.n_threads=1;
+    pc.n_threads=1;
+  }
     
   tmgr.report();
   return 0;
@@ -26,6 +26,13 @@
 #include <o2scl/lib_settings.h>
 #include <o2scl/hdf_io.h>
 
+#include <atomic>
+#include <sstream>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_hdf;
@@ -36,6 +43,7 @@ eos_sn_base::eos_sn_base() : cu(o2scl_settings.get_convert_units()) {
   n_Ye=0;
   n_T=0;
   n_oth=0;
+  n_interleaved=0;
 
   arr[0]=&F;
   arr[1]=&Fint;
@@ -250,6 +258,7 @@ void eos_sn_base::load(std::string fname) {
 }
 
 void eos_sn_base::alloc() {
+  clear_interleaved();
   size_t dim[3]={n_nB,n_Ye,n_T};
   for(size_t i=0;i<n_base+n_oth;i++) {
     arr[i]->resize(3,dim);
@@ -267,11 +276,83 @@ void eos_sn_base::free() {
     }
   }
   loaded=false;
+  clear_interleaved();
   oth_names.clear();
   oth_units.clear();
   return;
 }
 
+void eos_sn_base::build_interleaved() {
+  
+  if (loaded==false) {
+    O2SCL_ERR2("No data loaded (loaded=false) in ",
+	       "eos_sn_base::build_interleaved().",exc_einval);
+  }
+
+  size_t nq=n_base+n_oth;
+  size_t npts=F.total_size();
+  for(size_t i=0;i<nq;i++) {
+    if (arr[i]->total_size()!=npts) {
+      O2SCL_ERR2("Tensor sizes do not match in ",
+		 "eos_sn_base::build_interleaved().",exc_einval);
+    }
+  }
+  
+  interleaved.resize(npts*nq);
+  for(size_t i=0;i<nq;i++) {
+    const std::vector<double> &data=arr[i]->get_data();
+    for(size_t j=0;j<npts;j++) {
+      interleaved[j*nq+i]=data[j];
+    }
+  }
+  n_interleaved=nq;
+  
+  return;
+}
+
+void eos_sn_base::clear_interleaved() {
+  interleaved.clear();
+  n_interleaved=0;
+  return;
+}
+
+void eos_sn_base::get_all(double nB, double Ye, double T,
+			  std::vector<double> &out) {
+  
+  if (loaded==false) {
+    O2SCL_ERR2("No data loaded (loaded=false) in ",
+	       "eos_sn_base::get_all().",exc_einval);
+  }
+
+  // All of the tensors share the same grid, so the interval search
+  // is done only once using F
+  double pt[3]={nB,Ye,T};
+  size_t index[8];
+  double weight[8];
+  F.interp_linear_stencil(pt,index,weight);
+
+  size_t nq=n_base+n_oth;
+  out.resize(nq);
+  
+  if (n_interleaved==nq) {
+    for(size_t i=0;i<nq;i++) out[i]=0.0;
+    for(size_t c=0;c<8;c++) {
+      const double *row=&interleaved[index[c]*nq];
+      double w=weight[c];
+      for(size_t i=0;i<nq;i++) out[i]+=w*row[i];
+    }
+  } else {
+    for(size_t i=0;i<nq;i++) {
+      const std::vector<double> &data=arr[i]->get_data();
+      double sum=0.0;
+      for(size_t c=0;c<8;c++) sum+=weight[c]*data[index[c]];
+      out[i]=sum;
+    }
+  }
+  
+  return;
+}
+
 void eos_sn_base::set_interp_type(size_t interp_type) {
   if (!loaded) {
     O2SCL_ERR("File not loaded in eos_sn_base::set_interp().",
@@ -285,9 +366,17 @@ void eos_sn_base::set_interp_type(size_t interp_type) {
 
 void eos_sn_base::compute_eg_point(double nB, double Ye, double T,
 				   thermo &th) {
+  compute_eg_point_ext(nB,Ye,T,th,relf,electron,muon,photon,false);
+  return;
+}
+
+void eos_sn_base::compute_eg_point_ext(double nB, double Ye, double T,
+				       thermo &th, fermion_rel &fr,
+				       fermion &e, fermion &mu, boson &ph,
+				       bool warm_start) {
   
-  photon.massless_calc(T/hc_mev_fm);
-  electron.n=nB*Ye;
+  ph.massless_calc(T/hc_mev_fm);
+  e.n=nB*Ye;
   
   // AWS: 11/1/16: I had problems with the electron calculation
   // not working, presumably because of a bad initial guess for the
@@ -296,35 +385,39 @@ void eos_sn_base::compute_eg_point(double nB, double Ye, double T,
 
   // AWS: 07/25/18: I removed this because the fermion_rel class
   // now has better convergence properties
-  if (false) {
-    
-    double deg=electron.n/pow(T/hc_mev_fm,3.0);
-    if (deg>10.0) {
-      // If it's very degenerate, start with a guess
-      // without positrons
-      relf.calc_density(electron,T/hc_mev_fm);
-    }
+
+  bool solved=false;
+  if (warm_start && std::isfinite(e.mu) && e.mu>0.0) {
+    // Use the chemical potential already stored in the electron
+    // object, and fall back to the default guess if that fails
+    bool err_temp=fr.err_nonconv;
+    fr.err_nonconv=false;
+    int ret=fr.pair_density(e,T/hc_mev_fm);
+    fr.err_nonconv=err_temp;
+    if (ret==0 && std::isfinite(e.mu)) solved=true;
+    else e.n=nB*Ye;
   }
 
-  // Provide a consistent initial guess for the electron
-  // chemical potential
-  electron.mu=electron.m;
-  
-  relf.pair_density(electron,T/hc_mev_fm);
+  if (!solved) {
+    // Provide a consistent initial guess for the electron
+    // chemical potential
+    e.mu=e.m;
+    fr.pair_density(e,T/hc_mev_fm);
+  }
   
   if (include_muons) {
-    muon.mu=electron.mu;
-    relf.pair_mu(muon,T/hc_mev_fm);
+    mu.mu=e.mu;
+    fr.pair_mu(mu,T/hc_mev_fm);
   }
 
-  th.ed=electron.ed+photon.ed;
-  th.pr=electron.pr+photon.pr;
-  th.en=electron.en+photon.en;
+  th.ed=e.ed+ph.ed;
+  th.pr=e.pr+ph.pr;
+  th.en=e.en+ph.en;
   
   if (include_muons) {
-    th.ed+=muon.ed;
-    th.en+=muon.en;
-    th.pr+=muon.pr;
+    th.ed+=mu.ed;
+    th.en+=mu.en;
+    th.pr+=mu.pr;
   }
 
   return;
@@ -341,26 +434,56 @@ void eos_sn_base::compute_eg() {
 	       "eos_sn_base::compute_eg().",exc_einval);
   }
 
-  for(int i=n_nB-1;i>=0;i--) {
-    if (verbose>0 && i%5==0) {
-      cout << (i+1) << "/" << n_nB << endl;
-    }
-    for(size_t j=0;j<n_Ye;j++) {
-      for(size_t k=0;k<n_T;k++) {
+  // Each (nB,T) pair is handled by one thread, which proceeds
+  // along the Ye axis using the electron chemical potential from
+  // the previous point as the initial guess
+  size_t n_lines=n_nB*n_T;
+  size_t n_report=n_lines/20;
+  if (n_report==0) n_report=1;
+  std::atomic<size_t> n_done(0);
+  
+  int n_thr=1;
+#ifdef O2SCL_OPENMP
+  n_thr=omp_get_max_threads();
+#endif
+  
+#ifdef O2SCL_OPENMP
+#pragma omp parallel default(shared) num_threads(n_thr)
+#endif
+  {
+    // Thread-local copies of the particles
+    fermion e=electron, mu=muon;
+    boson ph=photon;
+
+    // With only one thread, relf is used directly. Otherwise each
+    // thread uses a separate fermion_rel object with the settings
+    // and the tabulated approximation from relf
+    fermion_rel fr_thr;
+    if (n_thr>1) fr_thr.copy_settings(relf);
+    fermion_rel &fr=((n_thr>1) ? fr_thr : relf);
+    
+#ifdef O2SCL_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for(size_t ik=0;ik<n_lines;ik++) {
+      
+      size_t i=ik/n_T, k=ik%n_T;
+      
+      for(size_t j=0;j<n_Ye;j++) {
 
 	double nb1, ye1, T1;
 	nb1=E.get_grid(0,i);
 	ye1=E.get_grid(1,j);
 	T1=E.get_grid(2,k);
-
+	
 	thermo th;
-	compute_eg_point(nb1,ye1,T1,th);
+	compute_eg_point_ext(nb1,ye1,T1,th,fr,e,mu,ph,j>0);
 	
 	double E_eg=th.ed/nb1*hc_mev_fm;
 	double P_eg=th.pr*hc_mev_fm;
 	double S_eg=th.en/nb1;
 	double F_eg=E_eg-T1*S_eg;
-
+	
 	if (baryons_only_loaded==true) {
 	  E.set(i,j,k,Eint.get(i,j,k)+E_eg);
 	  P.set(i,j,k,Pint.get(i,j,k)+P_eg);
@@ -373,6 +496,15 @@ void eos_sn_base::compute_eg() {
 	  Fint.set(i,j,k,F.get(i,j,k)-F_eg);
 	}
       }
+
+      // Only the thread which completes a multiple of n_report
+      // lines writes the progress report
+      size_t count=++n_done;
+      if (verbose>0 && count%n_report==0) {
+	std::ostringstream oss;
+	oss << count << "/" << n_lines << '\n';
+	cout << oss.str() << std::flush;
+      }
     }
   }
 
@@ -381,6 +513,8 @@ void eos_sn_base::compute_eg() {
   } else {
     baryons_only_loaded=true;
   }
+
+  if (interleaved_built()) build_interleaved();
   
   return;
 }
@@ -208,6 +208,45 @@ namespace o2scl {
 	to linear interpolation.
     */
     void set_interp_type(size_t interp_type);
+
+    /** \brief Create a copy of the data in which all of the
+	quantities at each grid point are stored contiguously
+
+	This copies the data from the \ref n_base base tensors
+	followed by the \ref n_oth additional tensors into a single
+	vector, with all quantities for one grid point stored
+	together in the same order as in \ref arr. This speeds up
+	\ref get_all() at the cost of doubling the memory used. The
+	copy is discarded when the data is freed or reallocated, and
+	is rebuilt by \ref compute_eg(). If the data in the tensors
+	is otherwise modified, this function must be called again.
+    */
+    void build_interleaved();
+
+    /// Discard the interleaved copy of the data
+    void clear_interleaved();
+
+    /// Return true if the interleaved copy of the data is present
+    bool interleaved_built() const {
+      return n_interleaved>0;
+    }
+
+    /** \brief Linearly interpolate all quantities at the point
+	(\c nB, \c Ye, \c T) and store them in \c out
+
+	The results for the \ref n_base base quantities followed by
+	the \ref n_oth additional quantities are stored in \c out
+	in the same order as in \ref arr. The grid interval search
+	is performed only once and the eight corners of the
+	enclosing cube are visited once for all quantities. If
+	\ref build_interleaved() has been called, the data is read
+	from the interleaved copy so that all values at each corner
+	are contiguous in memory.
+
+	The results are identical to those given by
+	\ref o2scl::tensor_grid3::interp_linear() for each tensor.
+    */
+    void get_all(double nB, double Ye, double T, std::vector<double> &out);
     //@}
 
     /// \name Nucleon masses
@@ -249,6 +288,18 @@ namespace o2scl {
 	The electron contribution to the internal energy and free
 	energy computed by this function includes the electron rest
 	mass.
+
+	If <tt>O2SCL_OPENMP</tt> is defined, the lines of constant
+	baryon density and temperature are distributed among the
+	OpenMP threads, each of which uses its own copies of \ref
+	electron, \ref muon, and \ref photon. If more than one
+	thread is used, each thread also uses its own \ref
+	fermion_rel object, set up with fermion_rel::copy_settings()
+	from \ref relf (see the documentation of that function for
+	which settings are copied). Otherwise \ref relf is used
+	directly. Along each line,
+	the electron chemical potential from the previous value of
+	the electron fraction is used as the initial guess.
     */
     virtual void compute_eg();
 
@@ -452,6 +503,27 @@ namespace o2scl {
     void alloc();
     //@}
 
+    /** \brief Compute the lepton and photon contribution at one
+	point using the specified objects
+
+	If \c warm_start is true, the chemical potential stored in
+	\c e is used as the initial guess, otherwise (or if the
+	solver fails with that guess) the electron mass is used.
+    */
+    void compute_eg_point_ext(double nB, double Ye, double T,
+			      thermo &th, fermion_rel &fr, fermion &e,
+			      fermion &mu, boson &ph, bool warm_start);
+
+    /// \name Interleaved storage
+    //@{
+    /** \brief All quantities stored contiguously for each grid point 
+	(see \ref build_interleaved())
+    */
+    std::vector<double> interleaved;
+    /// The number of quantities per grid point in \ref interleaved 
+    size_t n_interleaved;
+    //@}
+
   };
 
   /** \brief The Lattimer-Swesty supernova EOS 
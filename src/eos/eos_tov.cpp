@@ -425,6 +425,9 @@ eos_tov_interp::eos_tov_interp() {
   gen_int.set_type(itp_linear);
 
   err_nonconv=true;
+
+  fast_n=0;
+  fast_on=false;
 }
 
 eos_tov_interp::~eos_tov_interp() {
@@ -693,6 +696,109 @@ void eos_tov_interp::internal_read() {
     pnb_int.set(full_nlines,full_vecp,full_vecnb,itp_linear);
   }
 
+  fast_build();
+
+  return;
+}
+
+void eos_tov_interp::set_fast_lookup(size_t n_grid) {
+  if (n_grid==1) {
+    O2SCL_ERR2("Fast lookup table requires at least two points in ",
+	       "eos_tov_interp::set_fast_lookup().",exc_einval);
+  }
+  fast_n=n_grid;
+  if (full_vecp.size()>0) {
+    fast_build();
+  } else {
+    fast_on=false;
+  }
+  return;
+}
+
+void eos_tov_interp::fast_coeffs(const std::vector<double> &y,
+				 std::vector<double> &c) {
+
+  // The grid spacing is normalized to unity, so the slopes below are
+  // derivatives with respect to the fractional index
+  size_t n=y.size();
+  std::vector<double> m(n);
+  m[0]=y[1]-y[0];
+  m[n-1]=y[n-1]-y[n-2];
+  for(size_t i=1;i<n-1;i++) {
+    double d0=y[i]-y[i-1];
+    double d1=y[i+1]-y[i];
+    // The harmonic mean ensures that the interpolant is monotonic
+    if (d0*d1>0.0) {
+      m[i]=2.0*d0*d1/(d0+d1);
+    } else {
+      m[i]=0.0;
+    }
+  }
+  
+  c.resize(4*(n-1));
+  for(size_t i=0;i<n-1;i++) {
+    double d=y[i+1]-y[i];
+    c[4*i]=y[i];
+    c[4*i+1]=m[i];
+    c[4*i+2]=3.0*d-2.0*m[i]-m[i+1];
+    c[4*i+3]=m[i]+m[i+1]-2.0*d;
+  }
+  
+  return;
+}
+
+void eos_tov_interp::fast_build() {
+
+  fast_on=false;
+  if (fast_n<2 || full_vecp.size()<2) return;
+
+  double pr_lo=full_vecp[0];
+  double pr_hi=full_vecp[full_vecp.size()-1];
+  if (pr_lo<=0.0 || pr_hi<=pr_lo) return;
+
+  double x_lo=log(pr_lo);
+  double x_hi=log(pr_hi);
+  double dx=(x_hi-x_lo)/((double)(fast_n-1));
+
+  std::vector<double> ye(fast_n), ynb;
+  if (baryon_column) ynb.resize(fast_n);
+  
+  for(size_t i=0;i<fast_n;i++) {
+    double pr;
+    if (i==0) {
+      pr=pr_lo;
+    } else if (i==fast_n-1) {
+      pr=pr_hi;
+    } else {
+      pr=exp(x_lo+dx*((double)i));
+    }
+    double ed=pe_int.eval(pr);
+    if (!(ed>0.0) || !std::isfinite(ed)) return;
+    ye[i]=log(ed);
+    if (baryon_column) {
+      double nb=pnb_int.eval(pr);
+      if (!(nb>0.0) || !std::isfinite(nb)) return;
+      ynb[i]=log(nb);
+    }
+  }
+
+  fast_coeffs(ye,fast_ce);
+  if (baryon_column) {
+    fast_coeffs(ynb,fast_cnb);
+  } else {
+    fast_cnb.clear();
+  }
+  
+  fast_x_lo=x_lo;
+  fast_x_hi=x_hi;
+  fast_dx_inv=1.0/dx;
+  fast_on=true;
+
+  if (verbose>1) {
+    cout << "eos_tov_interp::fast_build(): Constructed fast table with "
+	 << fast_n << " points." << endl;
+  }
+  
   return;
 }
 
@@ -1328,6 +1434,16 @@ void eos_tov_interp::gcp10_low_dens_eos(string model, bool external) {
 }
 
 void eos_tov_interp::ed_nb_from_pr(double pr, double &ed, double &nb) {
+  if (fast_on) {
+    ed_nb_from_pr_fast(pr,ed,nb);
+  } else {
+    ed_nb_from_pr_table(pr,ed,nb);
+  }
+  return;
+}
+
+void eos_tov_interp::ed_nb_from_pr_table(double pr, double &ed,
+					 double &nb) {
 
   if (!std::isfinite(pr)) {
     O2SCL_ERR("Pressure not finite in eos_tov_interp::ed_nb_from_pr().",
@@ -872,6 +872,68 @@ namespace o2scl {
 	zero or \ref baryon_column should be set to false
     */
     virtual void ed_nb_from_pr(double pr, double &ed, double &nb);
+
+    /** \brief Non-virtual version of \ref ed_nb_from_pr() which
+	uses the fast lookup table when it is available
+
+	Inside the range of the fast lookup table, this function
+	computes the grid index directly from \f$ \ln P \f$ and
+	evaluates the cubic with Horner's rule, so no bracket search
+	is required. Outside of the table, or if the table has not
+	been constructed, it falls back to the original
+	interpolation. This function is used by \ref tov_solve
+	to avoid a virtual function call in the ODE derivatives.
+    */
+    void ed_nb_from_pr_fast(double pr, double &ed, double &nb) {
+      double x=log(pr);
+      if (!fast_on || !(x>=fast_x_lo && x<=fast_x_hi)) {
+	ed_nb_from_pr_table(pr,ed,nb);
+	return;
+      }
+      double t=(x-fast_x_lo)*fast_dx_inv;
+      size_t i=(size_t)t;
+      if (i>fast_n-2) i=fast_n-2;
+      double u=t-((double)i);
+      const double *c=&fast_ce[4*i];
+      ed=exp(c[0]+u*(c[1]+u*(c[2]+u*c[3])));
+      if (baryon_column) {
+	c=&fast_cnb[4*i];
+	nb=exp(c[0]+u*(c[1]+u*(c[2]+u*c[3])));
+      }
+      return;
+    }
+    //@}
+
+    /// \name Fast lookup table
+    //@{
+    /** \brief Construct a fast lookup table with \c n_grid points
+	(0 to disable)
+
+	When enabled, the EOS is resampled onto a grid which is
+	uniform in \f$ \ln P \f$ each time the table is read,
+	and the energy density and baryon density are represented by
+	monotone (Fritsch-Butland) cubics in \f$ \ln \varepsilon \f$
+	and \f$ \ln n_B \f$ . The fast table is then used by
+	\ref ed_nb_from_pr() and \ref ed_nb_from_pr_fast() . The
+	other EOS functions are unaffected. Because the table is
+	resampled, the results differ slightly from the original
+	linear interpolation, and the difference decreases with
+	increasing \c n_grid . The table is read-only after it is
+	constructed, so the same object can be shared among several
+	threads.
+
+	If the EOS contains non-positive pressures, energy densities,
+	or baryon densities, the fast table cannot be constructed and
+	the original interpolation is used instead.
+    */
+    void set_fast_lookup(size_t n_grid);
+
+    /** \brief Return true if the fast lookup table has been
+	constructed
+    */
+    bool fast_lookup_ready() const {
+      return fast_on;
+    }
     //@}
 
     /// \name Other functions
@@ -917,6 +979,36 @@ namespace o2scl {
      */
     void internal_read();
 
+    /** \brief The original interpolation used by \ref
+	ed_nb_from_pr()
+    */
+    void ed_nb_from_pr_table(double pr, double &ed, double &nb);
+
+    /// \name Fast lookup table
+    //@{
+    /// Construct the fast lookup table from \ref pe_int and \ref pnb_int
+    void fast_build();
+
+    /// Compute the cubic coefficients for a uniformly-spaced vector
+    void fast_coeffs(const std::vector<double> &y,
+		     std::vector<double> &c);
+    
+    /// Number of grid points requested (default 0)
+    size_t fast_n;
+    /// True if the fast table is ready for use
+    bool fast_on;
+    /// Lower limit of \f$ \ln P \f$
+    double fast_x_lo;
+    /// Upper limit of \f$ \ln P \f$
+    double fast_x_hi;
+    /// Inverse of the grid spacing in \f$ \ln P \f$
+    double fast_dx_inv;
+    /// Coefficients for the energy density (4 per interval)
+    std::vector<double> fast_ce;
+    /// Coefficients for the baryon density (4 per interval)
+    std::vector<double> fast_cnb;
+    //@}
+
     /// \name Crust EOS
     //@{
     /// Set to true if we are using a crust EOS (default false)
@@ -368,6 +368,9 @@ eos_nstar_rot_L::eos_nstar_rot_L(bool rns_constants) {
 
 }
 
+nstar_rot::f_P_cache nstar_rot::fp_cache;
+std::mutex nstar_rot::fp_mutex;
+
 nstar_rot::nstar_rot() {
   verbose=1;
 
@@ -393,6 +396,7 @@ nstar_rot::nstar_rot() {
 
   P_2n.resize(MDIV+1,LMAX+1);
   P1_2n_1.resize(MDIV+1,LMAX+1);
+  sin_2n_1_theta.resize(MDIV+1,LMAX+1);
 
   D1_rho.resize(LMAX+1,SDIV+1);  
   D1_gamma.resize(LMAX+1,SDIV+1); 
@@ -790,6 +794,23 @@ double nstar_rot::legendre(int n, double x) {
 }
 
 void nstar_rot::comp_f_P() {
+
+  // If the tables for this grid have already been computed,
+  // then just copy them
+  {
+    std::lock_guard<std::mutex> lock(fp_mutex);
+    if (fp_cache.SDIV==SDIV && fp_cache.MDIV==MDIV &&
+	fp_cache.LMAX==LMAX && fp_cache.SMAX==SMAX) {
+      f_rho=fp_cache.f_rho;
+      f_gamma=fp_cache.f_gamma;
+      f_omega=fp_cache.f_omega;
+      P_2n=fp_cache.P_2n;
+      P1_2n_1=fp_cache.P1_2n_1;
+      sin_2n_1_theta=fp_cache.sin_2n_1_theta;
+      return;
+    }
+  }
+  
   // counter
   int n;                 
   // counter for s'
@@ -929,9 +950,26 @@ void nstar_rot::comp_f_P() {
     for(n=1;n<=LMAX;n++) {
       P_2n(i,n)=legendre(2*n,mu[i]);
       P1_2n_1(i,n)=gsl_sf_legendre_Plm(2*n-1,1,mu[i]);
+      sin_2n_1_theta(i,n)=sin((2.0*n-1.0)*theta[i]);
     }
   }
 
+  // Store the tables for later use
+  {
+    std::lock_guard<std::mutex> lock(fp_mutex);
+    fp_cache.SDIV=SDIV;
+    fp_cache.MDIV=MDIV;
+    fp_cache.LMAX=LMAX;
+    fp_cache.SMAX=SMAX;
+    fp_cache.f_rho=f_rho;
+    fp_cache.f_gamma=f_gamma;
+    fp_cache.f_omega=f_omega;
+    fp_cache.P_2n=P_2n;
+    fp_cache.P1_2n_1=P1_2n_1;
+    fp_cache.sin_2n_1_theta=sin_2n_1_theta;
+  }
+
+  return;
 }
 
 void nstar_rot::make_center(double e_center_loc) {
@@ -2701,6 +2739,9 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
       }
     }
 
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
     for(s=1;s<=s_temp;s++) {
       for(int m=1;m<=MDIV;m++) {
 	double rsm=rho(s,m);
@@ -2792,8 +2833,13 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
 
     }
 
-    for(n=1;n<=LMAX;n++) {
-      for(int k=1;k<=SDIV;k++) {
+    // Each (n,k) is independent, so the loop over k is
+    // parallelized and the order of each sum is unchanged
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(int k=1;k<=SDIV;k++) {
+      for(int n=1;n<=LMAX;n++) {
 	// Intermediate sums in eqns for rho, gamma, omega
 	double sum_rho=0.0, sum_gamma=0.0, sum_omega=0.0;
 	for(int m=1;m<=MDIV-2;m+=2) {
@@ -2802,10 +2848,10 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
 			     +4.0*P_2n(m+1,n)*S_rho(k,m+1) 
 			     +P_2n(m+2,n)*S_rho(k,m+2));
                        
-	  sum_gamma+=(DM/3.0)*(sin((2.0*n-1.0)*theta[m])*S_gamma(k,m)
-			       +4.0*sin((2.0*n-1.0)*theta[m+1])*
+	  sum_gamma+=(DM/3.0)*(sin_2n_1_theta(m,n)*S_gamma(k,m)
+			       +4.0*sin_2n_1_theta(m+1,n)*
 			       S_gamma(k,m+1)
-			       +sin((2.0*n-1.0)*theta[m+2])*S_gamma(k,m+2));
+			       +sin_2n_1_theta(m+2,n)*S_gamma(k,m+2));
   
 	  sum_omega+=(DM/3.0)*(sin_theta[m]*P1_2n_1(m,n)*S_omega(k,m)
 			       +4.0*sin_theta[m+1]*P1_2n_1(m+1,n)*
@@ -2835,8 +2881,11 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
       D2_omega(s,n)=0.0;
     }
 
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
     for(s=1;s<=SDIV;s++) {
-      for(n=1;n<=LMAX;n++) {
+      for(int n=1;n<=LMAX;n++) {
 	// Intermediate sums in eqns for rho, gamma, omega
 	double sum_rho=0.0, sum_gamma=0.0, sum_omega=0.0;
 	for(int k=1;k<=SDIV-2;k+=2) { 
@@ -2860,6 +2909,9 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
 
     // Summation of coefficients
 
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
     for(s=1;s<=SDIV;s++) {
       for(int m=1;m<=MDIV;m++) {
 
@@ -2875,7 +2927,7 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
 	double sum_omega=0.0;
 	double sum_gamma=0.0;
 
-	for(n=1;n<=LMAX;n++) {
+	for(int n=1;n<=LMAX;n++) {
 
 	  sum_rho+=-e_gsm*P_2n(m,n)*D2_rho(s,n); 
 
@@ -2886,7 +2938,7 @@ int nstar_rot::iterate(double r_ratio_loc, double tol_rel) {
 	    sum_omega+=-e_rsm*e_gsm*(P1_2n_1(m,n)/
 				     (2.0*n*(2.0*n-1.0)
 				      *temp1))*D2_omega(s,n);  
-	    sum_gamma+=-(2.0/PI)*e_gsm*(sin((2.0*n-1.0)*theta[m])
+	    sum_gamma+=-(2.0/PI)*e_gsm*(sin_2n_1_theta(m,n)
 					/((2.0*n-1.0)*temp1))*D2_gamma(s,n);
 	  }
 	}
@@ -3149,6 +3201,7 @@ void nstar_rot::resize(int MDIV_new, int SDIV_new, int LMAX_new,
 
   P_2n.resize(MDIV+1,LMAX+1);
   P1_2n_1.resize(MDIV+1,LMAX+1);
+  sin_2n_1_theta.resize(MDIV+1,LMAX+1);
 
   D1_rho.resize(LMAX+1,SDIV+1);  
   D1_gamma.resize(LMAX+1,SDIV+1); 
@@ -61,6 +61,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <mutex>
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
@@ -777,8 +778,42 @@ namespace o2scl {
     /** \brief Associated Legendre polynomial \f$ P^1_{2n-1}(\mu) \f$ 
      */ 
     ubmatrix P1_2n_1;
+    /** \brief The value \f$ \sin [(2n-1)\theta] \f$ 
+     */ 
+    ubmatrix sin_2n_1_theta;
     //@}
 
+    /** \brief Two-point functions and Legendre polynomials for
+	one grid, shared between all instances of \ref nstar_rot
+    */
+    class f_P_cache {
+    public:
+      /// \name The grid parameters
+      //@{
+      int SDIV=0;
+      int MDIV=0;
+      int LMAX=0;
+      double SMAX=0.0;
+      //@}
+      /// \name The tables computed by \ref comp_f_P()
+      //@{
+      tensor3<> f_rho;
+      tensor3<> f_gamma;
+      tensor3<> f_omega;
+      ubmatrix P_2n;
+      ubmatrix P1_2n_1;
+      ubmatrix sin_2n_1_theta;
+      //@}
+    };
+
+    /** \brief The tables from the most recent call to
+	\ref comp_f_P() with a new grid
+    */
+    static f_P_cache fp_cache;
+
+    /// Mutex for \ref fp_cache
+    static std::mutex fp_mutex;
+
     /** \brief Integrated term over m in eqn for \f$ \rho \f$ */
     ubmatrix D1_rho;
     /** \brief Integrated term over m in eqn for \f$ \gamma \f$ */
@@ -935,7 +970,11 @@ namespace o2scl {
 	\gamma \f$ and \f$ \omega \f$ (See \ref Komatsu89 for
 	details). Since the grid points are fixed, we can compute the
 	functions \ref f_rho, \ref f_gamma, \ref f_omega, \ref P_2n,
-	and \ref P1_2n_1 once at the beginning.
+	\ref P1_2n_1, and \ref sin_2n_1_theta once at the beginning.
+	
+	The results are stored in \ref fp_cache, and are copied
+	from there instead of recomputed if another object (or a 
+	call to \ref resize()) uses the same grid.
 
 	See Eqs. 27-29 of \ref Cook92 and Eqs. 33-35 of \ref
 	Komatsu89. This function is called by the constructor.
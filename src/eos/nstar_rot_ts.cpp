@@ -62,6 +62,15 @@ int main(void) {
     nst.test7(t);
     nst.test8(t);
     nst.constants_o2scl();
+
+    // A second object with the same grid uses the cached two-point
+    // functions, and resizing to a different grid and back
+    // recomputes them
+    nstar_rot nst2;
+    nst2.test1(t);
+    nst2.resize(33,65,10,900);
+    nst2.resize(65,129,10,900);
+    nst2.test1(t);
   }
 
   if (true) {
@@ -25,12 +25,17 @@
 #endif
 
 #include <cstdlib>
+#include <algorithm>
 
 #include <boost/numeric/ublas/matrix_proxy.hpp>
 
 #include <o2scl/tov_solve.h>
 #include <o2scl/root_cern.h>
 
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
@@ -40,6 +45,7 @@ tov_solve::tov_solve() : out_table(new table_units<>) {
   // EOS
   eos_set=false;
   te=0;
+  te_interp=0;
 
   // Verbosity parameter
   verbose=1;
@@ -69,6 +75,8 @@ tov_solve::tov_solve() : out_table(new table_units<>) {
   prbegin=7.0e-7;
   prend=8.0e-3;
   princ=1.1;
+  mvsr_stop_at_max=true;
+  mvsr_refine=4;
 
   // Guess for pressure for fixed()
   fixed_pr_guess=5.2e-5;
@@ -239,7 +247,11 @@ int tov_solve::derivs(double r, size_t nv, const ubvector &y,
   // The function get_eden() is now already in the proper units,
   // so there's no need for unit conversion here
   double ed, nb;
-  te->ed_nb_from_pr(pres,ed,nb);
+  if (te_interp!=0 && te_interp->fast_lookup_ready()) {
+    te_interp->ed_nb_from_pr_fast(pres,ed,nb);
+  } else {
+    te->ed_nb_from_pr(pres,ed,nb);
+  }
   
   if (!std::isfinite(ed)) {
     return exc_efailed;
@@ -834,6 +846,121 @@ int tov_solve::integ_star(size_t ndvar, const ubvector &ndx,
   return 0;
 }
 
+int tov_solve::mvsr_star(double pcent, std::vector<double> &line) {
+
+  ubvector x(1), y(1);
+  x[0]=pcent;
+  integ_star_final=true;
+  int ret=integ_star(1,x,y);
+
+  line.clear();
+  
+  // --------------------------------------------------------------
+  // Fill line of data for table
+
+  // output mass and radius
+  line.push_back(mass);
+  line.push_back(rad);
+
+  // Gravitational potential and angular velocity columns
+  if (calc_gpot) {
+    line.push_back(gpot);
+    if (ang_vel) {
+      line.push_back(last_rjw);
+      line.push_back(last_f);
+    }
+  }
+
+  // output baryon mass
+  if (te->has_baryons()) line.push_back(bmass);
+  
+  // output central pressure, energy density, and baryon density
+
+  double ed, nb;
+  if (!std::isfinite(pcent)) {
+    O2SCL_ERR2("Central pressure not finite in ",
+	       "tov_solve::mvsr_star().",exc_efailed);
+  }
+  te->ed_nb_from_pr(pcent,ed,nb);
+  
+  // Convert pressure, energy density, and baryon density to user 
+  // units by dividing by their factors
+  line.push_back(pcent/pfactor);
+  line.push_back(ed/efactor);
+  if (te->has_baryons()) {
+    line.push_back(nb/nfactor);
+  }
+
+  // output surface gravity and redshift
+
+  if (rad!=0.0) {
+    line.push_back(schwarz_km/2.0*mass/rad/rad/
+		   sqrt(1.0-schwarz_km*mass/rad));
+    line.push_back(1.0/sqrt(1.0-mass*schwarz_km/rad)-1.0);
+  } else {
+    line.push_back(0.0);
+    line.push_back(0.0);
+  }
+  
+  // output derivatives
+
+  line.push_back(0.0);
+  line.push_back(0.0);
+  if (calc_gpot) line.push_back(0.0);
+  if (te->has_baryons()) line.push_back(0.0);
+
+  // Radius interpolation
+  if (pr_list.size()>0) {
+    iop.set_type(itp_linear);
+    ubvector lpr_col(rky.size()), gm_col(rky.size()), bm_col(rky.size());
+    for(size_t ii=0;ii<rky.size();ii++) {
+      lpr_col[ii]=rky[ii][1];
+      gm_col[ii]=rky[ii][0];
+      if (te->has_baryons()) {
+	size_t index=2;
+	if (calc_gpot) {
+	  index++;
+	  if (ang_vel) index+=2;
+	}
+	bm_col[ii]=rky[ii][index];
+      }
+    }
+    for(size_t ii=0;ii<pr_list.size();ii++) {
+      double thisr=iop.eval(log(pr_list[ii]*pfactor),
+			      ix_last-1,lpr_col,rkx);
+      double thisgm=iop.eval(log(pr_list[ii]*pfactor),
+			       ix_last-1,lpr_col,gm_col);
+      if (!std::isfinite(thisr)) {
+	string str=((string)"Obtained non-finite value when ")+
+	  "interpolating radius for pressure "+dtos(pr_list[ii])+
+	  " in tov_solve::mvsr_star().";
+	O2SCL_ERR(str.c_str(),exc_efailed);
+      }
+      line.push_back(thisr);
+      if (!std::isfinite(thisgm)) {
+	string str=((string)"Obtained non-finite value when ")+
+	  "interpolating gravitational mass for pressure "+dtos(pr_list[ii])+
+	  " in tov_solve::mvsr_star().";
+	O2SCL_ERR(str.c_str(),exc_efailed);
+      }
+      line.push_back(thisgm);
+      if (te->has_baryons()) {
+	double thisbm=iop.eval(log(pr_list[ii]*pfactor),
+			       ix_last-1,lpr_col,bm_col);
+	if (!std::isfinite(thisbm)) {
+	  string str=((string)"Obtained non-finite value when ")+
+	    "interpolating baryon mass for pressure "+dtos(pr_list[ii])+
+	    " in tov_solve::mvsr_star().";
+	  O2SCL_ERR(str.c_str(),exc_efailed);
+	}
+	line.push_back(thisbm);
+      }
+    }
+  }
+
+  return ret;
+}
+
 int tov_solve::mvsr() {
 
   int info=0;
@@ -855,144 +982,258 @@ int tov_solve::mvsr() {
   // ---------------------------------------------------------------
   // Main loop
 
-  ubvector x(1), y(1);
-  for (x[0]=prbegin;((prend>prbegin && x[0]<=prend) ||
-		     (prend<prbegin && x[0]>=prend));) {
+  for (double pcent=prbegin;((prend>prbegin && pcent<=prend) ||
+			     (prend<prbegin && pcent>=prend));) {
     
-    integ_star_final=true;
-    int ret=integ_star(1,x,y);
+    std::vector<double> line;
+    int ret=mvsr_star(pcent,line);
     if (ret!=0 && info==0) {
       O2SCL_CONV((((string)"Integration of star with central pressure ")
-		  +dtos(x[0])+" failed in mvsr().").c_str(),exc_efailed,
+		  +dtos(pcent)+" failed in mvsr().").c_str(),exc_efailed,
 		 err_nonconv);
       info+=mvsr_integ_star_failed+ret;
     }
       
     // --------------------------------------------------------------
-    // Fill line of data for table
+    // Copy line of data to table
+    
+    out_table->line_of_data(line.size(),&(line[0]));
+    if (line.size()!=out_table->get_ncolumns()) {
+      O2SCL_ERR("Table size problem in tov_solve::mvsr().",
+		exc_esanity);
+    }
+    
+    // --------------------------------------------------------------
+    // Get next central pressure
 
-    std::vector<double> line;
+    pcent*=princ;
 
-    // output mass and radius
-    line.push_back(mass);
-    line.push_back(rad);
+  }
 
-    // Gravitational potential and angular velocity columns
-    if (calc_gpot) {
-      line.push_back(gpot);
-      if (ang_vel) {
-	line.push_back(last_rjw);
-	line.push_back(last_f);
-      }
+  // Find the row that refers to the maximum mass star
+  size_t ix=out_table->lookup("gm",out_table->max("gm"));
+  pcent_max=out_table->get("pr",ix);
+
+  return info;
+}
+
+void tov_solve::mvsr_para_list(std::vector<tov_solve *> &ts_thr,
+			       const std::vector<double> &prs,
+			       std::vector<std::vector<double> > &lines,
+			       std::vector<int> &rets) {
+
+  size_t np=prs.size();
+  lines.resize(np);
+  rets.resize(np);
+  
+#ifdef O2SCL_OPENMP
+
+  o2scl::err_para_store eps(np);
+  
+  int n_threads=((int)ts_thr.size());
+#pragma omp parallel default(shared) num_threads(n_threads)
+  {
+    tov_solve *tsp=ts_thr[omp_get_thread_num()];
+#pragma omp for schedule(dynamic)
+    for(size_t i=0;i<np;i++) {
+      eps.run(i,[&]() {
+	  rets[i]=tsp->mvsr_star(prs[i],lines[i]);
+	});
     }
+  }
+  // End of parallel region
 
-    // output baryon mass
-    if (te->has_baryons()) line.push_back(bmass);
-    
-    // output central pressure, energy density, and baryon density
+  eps.rethrow();
+  
+#else
+  
+  for(size_t i=0;i<np;i++) {
+    rets[i]=ts_thr[0]->mvsr_star(prs[i],lines[i]);
+  }
+  
+#endif
 
-    double ed, nb;
-    if (!std::isfinite(x[0])) {
-      O2SCL_ERR2("Central pressure not finite in ",
-		 "tov_solve::mvsr().",exc_efailed);
+  return;
+}
+
+int tov_solve::mvsr_para(std::vector<tov_solve *> &ts_thr) {
+
+  int info=0;
+  pcent_max=pmax_default;
+
+  if (eos_set==false) {
+    O2SCL_ERR
+      ("EOS not specified tov_solve::mvsr_para().",exc_efailed);
+  }
+  size_t n_threads=ts_thr.size();
+  if (n_threads==0) {
+    O2SCL_ERR2("No tov_solve objects specified in ",
+	       "tov_solve::mvsr_para().",exc_einval);
+  }
+
+  // The thread objects, which may include this one, must not
+  // produce output, so the value of verbose is restored below
+  int verbose_save=verbose;
+  
+  // Copy the settings to the objects for each thread
+  for(size_t i=0;i<n_threads;i++) {
+    tov_solve &ts=*ts_thr[i];
+    if (ts.eos_set==false) {
+      O2SCL_ERR2("EOS not specified for thread object in ",
+		 "tov_solve::mvsr_para().",exc_efailed);
     }
-    te->ed_nb_from_pr(x[0],ed,nb);
-    
-    // Convert pressure, energy density, and baryon density to user 
-    // units by dividing by their factors
-    line.push_back(x[0]/pfactor);
-    line.push_back(ed/efactor);
-    if (te->has_baryons()) {
-      line.push_back(nb/nfactor);
+    if (&ts!=this) {
+      ts.buffer_size=buffer_size;
+      ts.baryon_mass=baryon_mass;
+      ts.ang_vel=ang_vel;
+      ts.gen_rel=gen_rel;
+      ts.calc_gpot=calc_gpot;
+      ts.step_min=step_min;
+      ts.step_max=step_max;
+      ts.step_start=step_start;
+      ts.max_integ_steps=max_integ_steps;
+      ts.err_nonconv=err_nonconv;
+      ts.min_log_pres=min_log_pres;
+      ts.efactor=efactor;
+      ts.pfactor=pfactor;
+      ts.nfactor=nfactor;
+      ts.pr_list=pr_list;
+      ts.schwarz_km=schwarz_km;
+      ts.def_stepper.con.eps_abs=def_stepper.con.eps_abs;
+      ts.def_stepper.con.eps_rel=def_stepper.con.eps_rel;
+      ts.def_stepper.con.a_y=def_stepper.con.a_y;
+      ts.def_stepper.con.a_dydt=def_stepper.con.a_dydt;
+      ts.def_stepper.con.standard=def_stepper.con.standard;
     }
+    ts.verbose=0;
+    ts.pcent_max=pcent_max;
+  }
+  
+  if (verbose_save>0) {
+    cout << "Mass versus radius mode with " << n_threads
+	 << " threads." << endl;
+  }
 
-    // output surface gravity and redshift
+  // ---------------------------------------------------------------
+  // Clear previously stored data and setup table
+  
+  out_table->clear();
+  column_setup(true);
 
-    if (rad!=0.0) {
-      line.push_back(schwarz_km/2.0*mass/rad/rad/
-		     sqrt(1.0-schwarz_km*mass/rad));
-      line.push_back(1.0/sqrt(1.0-mass*schwarz_km/rad)-1.0);
-    } else {
-      line.push_back(0.0);
-      line.push_back(0.0);
+  // ---------------------------------------------------------------
+  // Compute the stars on the central pressure grid, n_threads at 
+  // a time, until the maximum mass is bracketed
+
+  bool increasing=(prend>prbegin);
+  std::vector<double> prs;
+  for (double pcent=prbegin;((increasing && pcent<=prend) ||
+			     (!increasing && pcent>=prend));pcent*=princ) {
+    prs.push_back(pcent);
+  }
+
+  std::vector<std::vector<double> > lines;
+  std::vector<int> rets;
+  size_t n_done=0;
+  bool bracketed=false;
+  // The index of the maximum mass configuration in prs
+  size_t i_max=0;
+  bool max_found=false;
+  
+  while (n_done<prs.size() && bracketed==false) {
+
+    size_t n_batch=n_threads;
+    if (n_batch>prs.size()-n_done) n_batch=prs.size()-n_done;
+
+    std::vector<double> prs_batch(prs.begin()+n_done,
+				  prs.begin()+n_done+n_batch);
+    std::vector<std::vector<double> > lines_batch;
+    std::vector<int> rets_batch;
+    mvsr_para_list(ts_thr,prs_batch,lines_batch,rets_batch);
+    for(size_t i=0;i<n_batch;i++) {
+      lines.push_back(lines_batch[i]);
+      rets.push_back(rets_batch[i]);
+    }
+    n_done+=n_batch;
+
+    // Update the maximum mass, ignoring failed integrations
+    for(size_t i=n_done-n_batch;i<n_done;i++) {
+      if (rets[i]==0 && (max_found==false ||
+			 lines[i][0]>lines[i_max][0])) {
+	i_max=i;
+	max_found=true;
+      }
     }
     
-    // output derivatives
-
-    line.push_back(0.0);
-    line.push_back(0.0);
-    if (calc_gpot) line.push_back(0.0);
-    if (te->has_baryons()) line.push_back(0.0);
-
-    // Radius interpolation
-    if (pr_list.size()>0) {
-      iop.set_type(itp_linear);
-      ubvector lpr_col(rky.size()), gm_col(rky.size()), bm_col(rky.size());
-      for(size_t ii=0;ii<rky.size();ii++) {
-	lpr_col[ii]=rky[ii][1];
-	gm_col[ii]=rky[ii][0];
-	if (te->has_baryons()) {
-	  size_t index=2;
-	  if (calc_gpot) {
-	    index++;
-	    if (ang_vel) index+=2;
-	  }
-	  bm_col[ii]=rky[ii][index];
-	}
+    // Stop when a configuration with larger central pressure has a
+    // smaller mass than the maximum
+    if (mvsr_stop_at_max && increasing && max_found && i_max>0) {
+      for(size_t i=i_max+1;i<n_done;i++) {
+	if (rets[i]==0 && lines[i][0]<lines[i_max][0]) bracketed=true;
       }
-      for(size_t ii=0;ii<pr_list.size();ii++) {
-	double thisr=iop.eval(log(pr_list[ii]*pfactor),
-				ix_last-1,lpr_col,rkx);
-	double thisgm=iop.eval(log(pr_list[ii]*pfactor),
-				 ix_last-1,lpr_col,gm_col);
-	if (!std::isfinite(thisr)) {
-	  string str=((string)"Obtained non-finite value when ")+
-	    "interpolating radius for pressure "+dtos(pr_list[ii])+
-	    " in tov_solve::mvsr().";
-	  O2SCL_ERR(str.c_str(),exc_efailed);
-	}
-	line.push_back(thisr);
-	if (!std::isfinite(thisgm)) {
-	  string str=((string)"Obtained non-finite value when ")+
-	    "interpolating gravitational mass for pressure "+dtos(pr_list[ii])+
-	    " in tov_solve::mvsr().";
-	  O2SCL_ERR(str.c_str(),exc_efailed);
-	}
-	line.push_back(thisgm);
-	if (te->has_baryons()) {
-	  double thisbm=iop.eval(log(pr_list[ii]*pfactor),
-				 ix_last-1,lpr_col,bm_col);
-	  if (!std::isfinite(thisbm)) {
-	    string str=((string)"Obtained non-finite value when ")+
-	      "interpolating baryon mass for pressure "+dtos(pr_list[ii])+
-	      " in tov_solve::mvsr().";
-	    O2SCL_ERR(str.c_str(),exc_efailed);
-	  }
-	  line.push_back(thisbm);
-	}
+    }
+  }
+
+  if (verbose_save>0 && bracketed) {
+    cout << "Maximum mass bracketed after " << n_done << " of "
+	 << prs.size() << " central pressures." << endl;
+  }
+  
+  // ---------------------------------------------------------------
+  // Add points on either side of the maximum mass configuration
+
+  prs.resize(n_done);
+  if (mvsr_refine>0 && max_found && i_max>0 && i_max+1<n_done) {
+    std::vector<double> prs_ref;
+    for(size_t k=0;k<2;k++) {
+      double p_lo=prs[i_max-1+k];
+      double p_hi=prs[i_max+k];
+      for(size_t j=1;j<=mvsr_refine;j++) {
+	prs_ref.push_back(p_lo*pow(p_hi/p_lo,((double)j)/
+				   ((double)(mvsr_refine+1))));
       }
     }
+    std::vector<std::vector<double> > lines_ref;
+    std::vector<int> rets_ref;
+    mvsr_para_list(ts_thr,prs_ref,lines_ref,rets_ref);
+    for(size_t i=0;i<prs_ref.size();i++) {
+      prs.push_back(prs_ref[i]);
+      lines.push_back(lines_ref[i]);
+      rets.push_back(rets_ref[i]);
+    }
+  }
 
-    // --------------------------------------------------------------
-    // Copy line of data to table
-    
-    out_table->line_of_data(line.size(),&(line[0]));
-    if (line.size()!=out_table->get_ncolumns()) {
-      O2SCL_ERR("Table size problem in tov_solve::mvsr().",
+  // ---------------------------------------------------------------
+  // Sort by central pressure and copy the results to the table
+
+  std::vector<size_t> order(prs.size());
+  for(size_t i=0;i<prs.size();i++) order[i]=i;
+  std::sort(order.begin(),order.end(),
+	    [&prs,increasing](size_t i1, size_t i2) {
+	      if (increasing) return prs[i1]<prs[i2];
+	      return prs[i1]>prs[i2];
+	    });
+
+  for(size_t k=0;k<order.size();k++) {
+    size_t i=order[k];
+    if (rets[i]!=0 && info==0) {
+      O2SCL_CONV((((string)"Integration of star with central pressure ")
+		  +dtos(prs[i])+" failed in mvsr_para().").c_str(),
+		 exc_efailed,err_nonconv);
+      info+=mvsr_integ_star_failed+rets[i];
+    }
+    out_table->line_of_data(lines[i].size(),&(lines[i][0]));
+    if (lines[i].size()!=out_table->get_ncolumns()) {
+      O2SCL_ERR("Table size problem in tov_solve::mvsr_para().",
 		exc_esanity);
     }
-    
-    // --------------------------------------------------------------
-    // Get next central pressure
-
-    x[0]*=princ;
-
   }
 
   // Find the row that refers to the maximum mass star
   size_t ix=out_table->lookup("gm",out_table->max("gm"));
   pcent_max=out_table->get("pr",ix);
 
+  verbose=verbose_save;
+  
   return info;
 }
 
@@ -404,6 +404,14 @@ namespace o2scl {
     /// The EOS
     eos_tov *te;
 
+    /** \brief If the EOS is an \ref eos_tov_interp object, a pointer
+	to it, otherwise zero
+
+	This is used to call \ref eos_tov_interp::ed_nb_from_pr_fast()
+	directly when the fast lookup table is enabled.
+    */
+    eos_tov_interp *te_interp;
+
     /// True if the EOS has been set
     bool eos_set;
     //@}
@@ -479,6 +487,23 @@ namespace o2scl {
      */
     virtual int integ_star(size_t ndvar, const ubvector &ndx, 
 			ubvector &ndy);
+
+    /** \brief Integrate the star with central pressure \c pcent 
+	(in \f$ \mathrm{M}_{\odot}/\mathrm{km}^3 \f$) and store the
+	corresponding row of the \ref mvsr() table in \c line
+
+	This returns the value returned by \ref integ_star().
+    */
+    int mvsr_star(double pcent, std::vector<double> &line);
+
+    /** \brief Compute the rows of the \ref mvsr() table for
+	the central pressures in \c prs in parallel using the 
+	objects in \c ts_thr
+    */
+    void mvsr_para_list(std::vector<tov_solve *> &ts_thr,
+			const std::vector<double> &prs,
+			std::vector<std::vector<double> > &lines,
+			std::vector<int> &rets);
     
 #endif
 
@@ -582,6 +607,20 @@ namespace o2scl {
     double prend;
     /// Increment factor for pressure (default 1.1)
     double princ;
+    /** \brief If true, then \ref mvsr_para() stops once the
+	maximum mass has been bracketed (default true)
+
+	This is only used when \ref prend is larger than \ref
+	prbegin. Note that, for EOSs which have a second stable
+	branch at higher central pressures, this will omit the
+	second branch.
+    */
+    bool mvsr_stop_at_max;
+    /** \brief The number of additional central pressures
+	between each of the two grid points adjacent to the 
+	maximum mass star in \ref mvsr_para() (default 4)
+    */
+    size_t mvsr_refine;
     /** \brief List of pressures at which more information should be
 	recorded
 	
@@ -627,6 +666,7 @@ namespace o2scl {
     /// Set the EOS to use
     void set_eos(eos_tov &ter) {
       te=&ter;
+      te_interp=dynamic_cast<eos_tov_interp *>(&ter);
       eos_set=true;
       return;
     }
@@ -650,6 +690,40 @@ namespace o2scl {
      */
     virtual int mvsr();
 
+    /** \brief Calculate the mass vs. radius curve in parallel
+	using one \ref tov_solve object for each OpenMP thread
+
+	The number of threads is the size of \c ts_thr, and each
+	element is used to integrate the stars for one thread, so
+	each has its own ODE stepper and buffers. Each object must
+	have an EOS specified with \ref set_eos(). The same EOS
+	object may be shared between threads only if its
+	<tt>ed_nb_from_pr()</tt> function is thread-safe. The
+	integration settings, units, \ref pr_list and the tolerances
+	of the default adaptive stepper of this object are copied to
+	the other objects in \c ts_thr. A stepper specified with \ref
+	set_stepper() is not copied, because it cannot be shared
+	between threads, so it must be set separately for each
+	object in \c ts_thr. This object may itself be an element of
+	\c ts_thr. The value of \ref verbose is set to zero for all
+	of the objects in \c ts_thr during the computation (it is
+	restored afterwards for this object).
+
+	The central pressures are the same as in \ref mvsr(), but
+	they are computed \c n_threads at a time, and (if \ref
+	mvsr_stop_at_max is true) the computation stops once a
+	configuration with a larger central pressure than that of the
+	maximum mass star has a smaller mass. Afterwards, \ref
+	mvsr_refine additional central pressures are computed on
+	either side of the maximum mass star. The output table has
+	the same columns as that produced by \ref mvsr() and is
+	sorted by central pressure.
+
+	Without OpenMP, the first element of \c ts_thr is used
+	for all of the stars.
+    */
+    virtual int mvsr_para(std::vector<tov_solve *> &ts_thr);
+
     /** \brief Calculate the profile of a star with fixed mass
 
 	This function computes the profile for a star with a fixed
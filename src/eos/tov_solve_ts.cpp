@@ -329,6 +329,77 @@ int main(void) {
     hf.close();
   }
 
+  // --------------------------------------------------------------
+  // Mass vs. radius curve in parallel, with one EOS object and
+  // one tov_solve object for each thread
+
+  {
+    double gm_max_ser=tab->max("gm");
+    double r14_ser=tab->interp("gm",1.4,"r");
+    double r0_14_ser=tab->interp("gm",1.4,"r0");
+    
+    eos_tov_interp te_thr[2];
+    tov_solve at_thr[2];
+    std::vector<tov_solve *> ts_thr;
+    for(size_t i=0;i<2;i++) {
+      te_thr[i].default_low_dens_eos();
+      te_thr[i].read_table(eos,"ed","pr","nb");
+      at_thr[i].set_eos(te_thr[i]);
+      ts_thr.push_back(&at_thr[i]);
+    }
+    
+    cout << "Mass vs. radius curve in parallel: " << endl;
+    at.mvsr_para(ts_thr);
+    tab->summary(&cout);
+    cout << endl;
+    
+    t.test_rel(tab->max("gm"),gm_max_ser,1.0e-3,"mvsr_para max mass");
+    t.test_gen(tab->max("gm")>=gm_max_ser,"mvsr_para refined max mass");
+    t.test_rel(tab->interp("gm",1.4,"r"),r14_ser,1.0e-6,"mvsr_para r");
+    t.test_rel(tab->interp("gm",1.4,"r0"),r0_14_ser,1.0e-6,"mvsr_para r0");
+  }
+
+  cout << endl;
+
+  // --------------------------------------------------------------
+  // Mass vs. radius curve using the fast EOS lookup table
+
+  {
+    double gm_max_ser=tab->max("gm");
+    
+    eos_tov_interp te_fast;
+    te_fast.default_low_dens_eos();
+    te_fast.set_fast_lookup(10000);
+    te_fast.read_table(eos,"ed","pr","nb");
+    t.test_gen(te_fast.fast_lookup_ready(),"fast lookup ready");
+
+    // At the tabulated points the fast table should agree with
+    // the original linear interpolation
+    for(size_t i=0;i<te.full_vecp.size();i+=10) {
+      double ed1, nb1, ed2, nb2;
+      te.ed_nb_from_pr(te.full_vecp[i],ed1,nb1);
+      te_fast.ed_nb_from_pr(te.full_vecp[i],ed2,nb2);
+      t.test_rel(ed2,ed1,1.0e-3,"fast lookup ed");
+      t.test_rel(nb2,nb1,1.0e-3,"fast lookup nb");
+    }
+
+    tov_solve at_fast;
+    at_fast.verbose=0;
+    at_fast.set_eos(te_fast);
+    
+    cout << "Mass vs. radius curve with fast EOS lookup: " << endl;
+    at_fast.mvsr();
+    std::shared_ptr<table_units<> > tab_fast=at_fast.get_results();
+    tab_fast->summary(&cout);
+    cout << endl;
+    
+    t.test_rel(tab_fast->max("gm"),gm_max_ser,1.0e-3,"fast lookup max mass");
+
+    // Disabling the table returns to the original interpolation
+    te_fast.set_fast_lookup(0);
+    t.test_gen(!te_fast.fast_lookup_ready(),"fast lookup disabled");
+  }
+
   cout << endl;
 
   // --------------------------------------------------------------
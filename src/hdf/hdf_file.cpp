@@ -1606,6 +1606,106 @@ int hdf_file::setd_arr(std::string name, size_t n, const double *d) {
   return 0;
 }
 
+int hdf_file::setd_arr_extend(std::string name, size_t start, size_t n,
+			       const double *d) {
+  
+  if (write_access==false) {
+    O2SCL_ERR2("File not opened with write access in ",
+	       "hdf_file::setd_arr_extend().",exc_efailed);
+  }
+
+  hid_t dset, space;
+
+  H5E_BEGIN_TRY
+    {
+      // See if the dataspace already exists first
+      dset=H5Dopen(current,name.c_str(),H5P_DEFAULT);
+    } 
+  H5E_END_TRY 
+#ifdef O2SCL_NEVER_DEFINED
+    {
+    }
+#endif
+      
+  // If it doesn't exist, create it
+  if (dset<0) {
+
+    if (start>0) {
+      O2SCL_ERR2("Dataset does not exist and start is nonzero in ",
+		 "hdf_file::setd_arr_extend().",exc_einval);
+    }
+    
+    // Create the dataspace
+    hsize_t dims=n;
+    hsize_t max=H5S_UNLIMITED;
+    space=H5Screate_simple(1,&dims,&max);
+
+    // Since this dataset is likely to grow, make sure the chunks
+    // are not too small
+    hid_t dcpl=H5Pcreate(H5P_DATASET_CREATE);
+    hsize_t chunk=def_chunk(n>1000 ? n : 1000);
+    int status2=H5Pset_chunk(dcpl,1,&chunk);
+
+#ifdef O2SCL_HDF5_COMP    
+    // Compression part
+    if (compr_type==1) {
+      int status3=H5Pset_deflate(dcpl,6);
+    } else if (compr_type==2) {
+      int status3=H5Pset_szip(dcpl,H5_SZIP_NN_OPTION_MASK,16);
+    } else if (compr_type!=0) {
+      O2SCL_ERR2("Invalid compression type in ",
+		 "hdf_file::setd_arr_extend().",exc_einval);
+    }
+#endif
+
+    // Create the dataset
+    dset=H5Dcreate(current,name.c_str(),H5T_IEEE_F64LE,space,H5P_DEFAULT,
+		   dcpl,H5P_DEFAULT);
+    H5Pclose(dcpl);
+    
+  } else {
+    
+    // Get current dimensions
+    space=H5Dget_space(dset);  
+    hsize_t dims;
+    int ndims=H5Sget_simple_extent_dims(space,&dims,0);
+
+    // Set error if this dataset is more than 1-dimensional
+    if (ndims!=1) {
+      O2SCL_ERR2("Tried to set a multidimensional dataset with an ",
+		 "array in hdf_file::setd_arr_extend().",exc_einval);
+    }
+    if (start>dims) {
+      O2SCL_ERR2("Value of start larger than dataset size in ",
+		 "hdf_file::setd_arr_extend().",exc_einval);
+    }
+
+    // If necessary, resize the dataset and obtain the new dataspace
+    if (start+n!=dims) {
+      hsize_t new_dims=start+n;
+      int status3=H5Dset_extent(dset,&new_dims);
+      H5Sclose(space);
+      space=H5Dget_space(dset);
+    }
+    
+  }
+
+  // Write only the new data using a hyperslab
+  if (n>0) {
+    hsize_t offset=start, count=n;
+    H5Sselect_hyperslab(space,H5S_SELECT_SET,&offset,0,&count,0);
+    hid_t mem_space=H5Screate_simple(1,&count,0);
+    int status=H5Dwrite(dset,H5T_NATIVE_DOUBLE,mem_space,
+			space,H5P_DEFAULT,d);
+    H5Sclose(mem_space);
+  }
+  
+  H5Dclose(dset);
+  H5Sclose(space);
+      
+  return 0;
+}
+
 int hdf_file::setf_arr(std::string name, size_t n, const float *f) { 
   
   if (write_access==false) {
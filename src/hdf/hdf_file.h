@@ -974,6 +974,17 @@ namespace o2scl_hdf {
     /// Set a double array named \c name of size \c n to value \c d
     int setd_arr(std::string name, size_t n, const double *d);
 
+    /** \brief Write \c n values from \c d to a double array named
+	\c name beginning at index \c start
+
+	The dataset is resized to have exactly <tt>start+n</tt>
+	elements, so this function can be used to append data to an
+	existing dataset without rewriting the previous entries. If
+	the dataset does not exist, then \c start must be zero.
+    */
+    int setd_arr_extend(std::string name, size_t start, size_t n,
+			const double *d);
+
     /// Set a float array named \c name of size \c n to value \c f
     int setf_arr(std::string name, size_t n, const float *f);
 
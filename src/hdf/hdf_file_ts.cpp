@@ -65,6 +65,39 @@ int main(void) {
     hf.close();
     cout << endl;
   }
+
+  if (true) {
+    
+    // Test appending to an extendable dataset
+    cout << "Test setd_arr_extend()." << endl;
+
+    double d[6]={1.0,2.0,3.0,4.0,5.0,6.0};
+    hdf_file hf;
+    hf.open_or_create("hdf_file_extend.o2");
+    hf.setd_arr_extend("ext",0,2,d);
+    hf.setd_arr_extend("ext",2,3,d+2);
+    hf.setd_arr_extend("ext",5,0,d+5);
+    hf.setd_arr_extend("ext",5,1,d+5);
+    hf.close();
+
+    hf.open("hdf_file_extend.o2");
+    vector<double> v;
+    hf.getd_vec("ext",v);
+    hf.close();
+    t.test_gen(v.size()==6,"extend size");
+    t.test_rel_vec(6,v,d,1.0e-15,"extend values");
+
+    // Restarting at zero truncates the dataset
+    hf.open("hdf_file_extend.o2",true);
+    hf.setd_arr_extend("ext",0,3,d+3);
+    hf.close();
+    hf.open("hdf_file_extend.o2");
+    hf.getd_vec("ext",v);
+    hf.close();
+    t.test_gen(v.size()==3,"truncate size");
+    t.test_rel(v[0],4.0,1.0e-15,"truncate value");
+    cout << endl;
+  }
   
   // Uncompressed section
   {
@@ -30,7 +30,9 @@
 */
 
 #include <cmath>
+#include <vector>
 #include <gsl/gsl_integration.h>
+#include <o2scl/funct.h>
 #include <o2scl/inte.h>
 #include <o2scl/inte_gsl.h>
 #include <o2scl/string_conv.h>
@@ -638,6 +640,118 @@ namespace o2scl {
       /// Scratch space
       double *f_v2;
 
+      /// Abscissas for vectorized functions
+      std::vector<double> x_vec;
+
+      /// Function values for vectorized functions
+      std::vector<double> f_vec;
+
+      /** \brief Compute the Gauss-Kronrod sums from the function
+	  values \c fx on the interval from \c a to \c b
+
+	  The array \c fx contains the function value at the center
+	  of the interval, followed by the values at \f$ c-h x_j \f$
+	  and \f$ c+h x_j \f$ for each of the \ref n_gk-1 abscissas
+	  \f$ x_j \f$ .
+      */
+      void gauss_kronrod_sum(const double *fx, double a, double b,
+			     double *result, double *abserr,
+			     double *resabs, double *resasc) {
+	
+	const double half_length=0.5*(b-a);
+	const double abs_half_length=fabs (half_length);
+	  
+	double f_center=fx[0];
+	  
+	double result_gauss=0.0;
+	double result_kronrod=f_center*this->w_gk[this->n_gk-1];
+ 
+	double result_abs=fabs (result_kronrod);
+	double result_asc=0.0;
+	double mean=0.0, err=0.0;
+      
+	if (this->n_gk % 2 == 0) {
+	  result_gauss=f_center*this->w_g[this->n_gk / 2-1];
+	}
+      
+	// Sum up results from left half of interval
+	for (int j=0; j < (this->n_gk-1) / 2; j++) {
+
+	  const int jtw=j*2+1;        
+	  double fval1=fx[2*jtw+1];
+	  double fval2=fx[2*jtw+2];
+	      
+	  const double fsum=fval1+fval2;
+	  this->f_v1[jtw]=fval1;
+	  this->f_v2[jtw]=fval2;
+	  result_gauss+=this->w_g[j]*fsum;
+	  result_kronrod+=this->w_gk[jtw]*fsum;
+	  result_abs+=this->w_gk[jtw]*(fabs(fval1)+fabs(fval2));
+	}
+      
+	// Sum up results from right half of interval
+	for (int j=0; j < this->n_gk / 2; j++) {
+
+	  int jtwm1=j*2;
+	  double fval1=fx[2*jtwm1+1];
+	  double fval2=fx[2*jtwm1+2];
+
+	  this->f_v1[jtwm1]=fval1;
+	  this->f_v2[jtwm1]=fval2;
+	  result_kronrod+=this->w_gk[jtwm1]*(fval1+fval2);
+	  result_abs+=this->w_gk[jtwm1]*(fabs(fval1)+fabs(fval2));
+	}
+      
+	mean=result_kronrod*0.5;
+      
+	result_asc=this->w_gk[this->n_gk-1]*fabs(f_center-mean);
+	
+	for (int j=0;j<this->n_gk-1;j++) {
+	  result_asc+=this->w_gk[j]*(fabs(this->f_v1[j]-mean)+
+				     fabs(this->f_v2[j]-mean));
+	}
+      
+	/* Scale by the width of the integration region */
+      
+	err=(result_kronrod-result_gauss)*half_length;
+      
+	result_kronrod*=half_length;
+	result_abs*=abs_half_length;
+	result_asc*=abs_half_length;
+      
+	*result=result_kronrod;
+	*resabs=result_abs;
+	*resasc=result_asc;
+	*abserr=rescale_error(err,result_abs,result_asc);
+
+	return;
+      }
+
+      /** \brief Apply the rule to the \c n intervals specified in
+	  \c a and \c b using the user-specified function type
+      */
+      void gauss_kronrod_list(func_t &func, size_t n, const double *a,
+			      const double *b, double *result,
+			      double *abserr, double *resabs,
+			      double *resasc) {
+	for(size_t i=0;i<n;i++) {
+	  gauss_kronrod(func,a[i],b[i],&result[i],&abserr[i],
+			&resabs[i],&resasc[i]);
+	}
+	return;
+      }
+      
+      /** \brief Apply the rule to the \c n intervals specified in
+	  \c a and \c b using a vectorized function
+      */
+      void gauss_kronrod_list(funct_vec &func, size_t n, const double *a,
+			      const double *b, double *result,
+			      double *abserr, double *resabs,
+			      double *resasc) {
+	gauss_kronrod_vec(func,n,a,b,result,abserr,resabs,resasc);
+	return;
+      }
+      
   public:
 
       inte_kronrod_gsl() {
@@ -801,78 +915,74 @@ namespace o2scl {
 	
 	const double center=0.5*(a+b);
 	const double half_length=0.5*(b-a);
-	const double abs_half_length=fabs (half_length);
-	  
-	double f_center;
-	f_center=func(center);
-	  
-	double result_gauss=0.0;
-	double result_kronrod=f_center*this->w_gk[this->n_gk-1];
- 
-	double result_abs=fabs (result_kronrod);
-	double result_asc=0.0;
-	double mean=0.0, err=0.0;
-      
-	if (this->n_gk % 2 == 0) {
-	  result_gauss=f_center*this->w_g[this->n_gk / 2-1];
+
+	if (this->f_vec.size()<((size_t)(2*this->n_gk-1))) {
+	  this->f_vec.resize(2*this->n_gk-1);
 	}
-      
-	// Sum up results from left half of interval
+	double *fx=&(this->f_vec[0]);
+	
+	fx[0]=func(center);
+	  
+	// Evaluate the function on the left half of the interval
 	for (int j=0; j < (this->n_gk-1) / 2; j++) {
-
 	  const int jtw=j*2+1;        
 	  const double abscissa=half_length*this->x_gk[jtw];
-	      
-	  double fval1, fval2;
-	  fval1=func(center-abscissa);
-	  fval2=func(center+abscissa);
-	      
-	  const double fsum=fval1+fval2;
-	  this->f_v1[jtw]=fval1;
-	  this->f_v2[jtw]=fval2;
-	  result_gauss+=this->w_g[j]*fsum;
-	  result_kronrod+=this->w_gk[jtw]*fsum;
-	  result_abs+=this->w_gk[jtw]*(fabs(fval1)+fabs(fval2));
+	  fx[2*jtw+1]=func(center-abscissa);
+	  fx[2*jtw+2]=func(center+abscissa);
 	}
       
-	// Sum up results from right half of interval
+	// Evaluate the function on the right half of the interval
 	for (int j=0; j < this->n_gk / 2; j++) {
-
 	  int jtwm1=j*2;
 	  const double abscissa=half_length*this->x_gk[jtwm1];
+	  fx[2*jtwm1+1]=func(center-abscissa);
+	  fx[2*jtwm1+2]=func(center+abscissa);
+	}
+
+	gauss_kronrod_sum(fx,a,b,result,abserr,resabs,resasc);
+      
+	return;
+      }
 
-	  double fval1, fval2;
-	  fval1=func(center-abscissa);
-	  fval2=func(center+abscissa);
+      /** \brief The base Gauss-Kronrod integration function
+	  for vectorized functions
 
-	  this->f_v1[jtwm1]=fval1;
-	  this->f_v2[jtwm1]=fval2;
-	  result_kronrod+=this->w_gk[jtwm1]*(fval1+fval2);
-	  result_abs+=this->w_gk[jtwm1]*(fabs(fval1)+fabs(fval2));
+	  This function applies the rule to the \c n intervals
+	  specified in \c a and \c b . All of the \f$ n (2 \times
+	  \mathrm{n\_gk} - 1) \f$ abscissas are stored in one
+	  contiguous array and passed to \c func in a single call. The
+	  results are otherwise identical to those from \ref
+	  gauss_kronrod_base() .
+      */
+      template<class func2_t> void gauss_kronrod_vec_base
+	(func2_t &func, size_t n, const double *a, const double *b,
+	 double *result, double *abserr, double *resabs, double *resasc) {
+
+	const size_t n_pts=2*this->n_gk-1;
+	if (this->x_vec.size()<n*n_pts) {
+	  this->x_vec.resize(n*n_pts);
+	  this->f_vec.resize(n*n_pts);
 	}
-      
-	mean=result_kronrod*0.5;
-      
-	result_asc=this->w_gk[this->n_gk-1]*fabs(f_center-mean);
 	
-	for (int j=0;j<this->n_gk-1;j++) {
-	  result_asc+=this->w_gk[j]*(fabs(this->f_v1[j]-mean)+
-				     fabs(this->f_v2[j]-mean));
+	for(size_t i=0;i<n;i++) {
+	  const double center=0.5*(a[i]+b[i]);
+	  const double half_length=0.5*(b[i]-a[i]);
+	  double *x=&(this->x_vec[i*n_pts]);
+	  x[0]=center;
+	  for (int j=0;j<this->n_gk-1;j++) {
+	    const double abscissa=half_length*this->x_gk[j];
+	    x[2*j+1]=center-abscissa;
+	    x[2*j+2]=center+abscissa;
+	  }
 	}
-      
-	/* Scale by the width of the integration region */
-      
-	err=(result_kronrod-result_gauss)*half_length;
-      
-	result_kronrod*=half_length;
-	result_abs*=abs_half_length;
-	result_asc*=abs_half_length;
-      
-	*result=result_kronrod;
-	*resabs=result_abs;
-	*resasc=result_asc;
-	*abserr=rescale_error(err,result_abs,result_asc);
 
+	func(n*n_pts,&(this->x_vec[0]),&(this->f_vec[0]));
+
+	for(size_t i=0;i<n;i++) {
+	  gauss_kronrod_sum(&(this->f_vec[i*n_pts]),a[i],b[i],&result[i],
+			    &abserr[i],&resabs[i],&resasc[i]);
+	}
+	
 	return;
       }
 
@@ -886,6 +996,15 @@ namespace o2scl {
 					  
       }
     
+      /** \brief Integration wrapper for vectorized functions
+      */
+      virtual void gauss_kronrod_vec
+	(funct_vec &func, size_t n, const double *a, const double *b,
+	 double *result, double *abserr, double *resabs, double *resasc) {
+	return gauss_kronrod_vec_base<funct_vec>
+	  (func,n,a,b,result,abserr,resabs,resasc);
+      }
+    
     };
   
 #ifndef DOXYGEN_NO_O2NS
@@ -97,6 +97,20 @@ namespace o2scl {
     return qag(func,a,b,this->tol_abs,this->tol_rel,&res,&err);
   }
 
+  /** \brief Integrate the vectorized function \c func from \c a to
+      \c b and place the result in \c res and the error in \c err
+
+      The function \c func is called with all of the abscissas for
+      the two halves of each bisected subinterval in one array, so
+      that the function evaluations can be vectorized. The result is
+      the same as that from \ref integ_err() with the equivalent
+      scalar function.
+  */
+  virtual int integ_err_vec(funct_vec &func, double a, double b, 
+			    double &res, double &err) {
+    return qag(func,a,b,this->tol_abs,this->tol_rel,&res,&err);
+  }
+
 #ifndef DOXYGEN_INTERNAL
 
   protected:
@@ -106,7 +120,8 @@ namespace o2scl {
 
       \future Just move this function to integ_err().
   */
-  int qag(func_t &func, const double a, const double b, 
+  template<class func2_t>
+  int qag(func2_t &func, const double a, const double b, 
 	  const double l_epsabs, const double l_epsrel, 
 	  double *result, double *abserr) {
     
@@ -138,7 +153,8 @@ namespace o2scl {
 	
     /* perform the first integration */
     
-    this->gauss_kronrod(func,a,b,&result0,&abserr0,&resabs0,&resasc0);
+    this->gauss_kronrod_list(func,1,&a,&b,&result0,&abserr0,
+			     &resabs0,&resasc0);
     
     this->w->set_initial_result(result0,abserr0);
       
@@ -199,6 +215,8 @@ namespace o2scl {
       double error1 = 0, error2 = 0, error12 = 0;
       double resasc1, resasc2;
       double resabs1, resabs2;
+      double a12[2], b12[2], area_v[2], error_v[2];
+      double resasc_v[2], resabs_v[2];
 	  
       /* Bisect the subinterval with the largest error estimate */
 	  
@@ -209,8 +227,20 @@ namespace o2scl {
       a2 = b1;
       b2 = b_i;
       
-      this->gauss_kronrod(func,a1,b1,&area1,&error1,&resabs1,&resasc1);
-      this->gauss_kronrod(func,a2,b2,&area2,&error2,&resabs2,&resasc2);
+      a12[0]=a1;
+      b12[0]=b1;
+      a12[1]=a2;
+      b12[1]=b2;
+      this->gauss_kronrod_list(func,2,a12,b12,area_v,error_v,
+			       resabs_v,resasc_v);
+      area1=area_v[0];
+      error1=error_v[0];
+      resabs1=resabs_v[0];
+      resasc1=resasc_v[0];
+      area2=area_v[1];
+      error2=error_v[1];
+      resabs2=resabs_v[1];
+      resasc2=resasc_v[1];
       
       area12 = area1 + area2;
       error12 = error1 + error2;
@@ -35,6 +35,14 @@ double test_func_1(double x) {
   return -sin(1.0/(x+0.01))*pow(x+0.01,-2.0);
 }
 
+// Vectorized version of the above function
+void test_func_1_vec(size_t n, const double *x, double *y) {
+  for(size_t i=0;i<n;i++) {
+    y[i]=-sin(1.0/(x[i]+0.01))*pow(x[i]+0.01,-2.0);
+  }
+  return;
+}
+
 // A GSL-version of the above function
 double gsl_test_func_1(double x, void *pa) {
   return -sin(1.0/(x+0.01))*pow(x+0.01,-2.0);
@@ -109,6 +117,19 @@ int main(void) {
     cout << h << " " << ans << " " << it1.get_error() << " " 
 	 << exact << " " << fabs(ans-exact) << endl;
   }
+  it1.verbose=0;
+  cout << endl;
+
+  // Make sure the vectorized integrand gives the same results
+  funct_vec tf2_vec=test_func_1_vec;
+  for(int h=1;h<=6;h++) {
+    it1.set_rule(h);
+    double res1, err1, res2, err2;
+    it1.integ_err(tf2,0.0,1.0,res1,err1);
+    it1.integ_err_vec(tf2_vec,0.0,1.0,res2,err2);
+    t.test_rel(res2,res1,1.0e-15,"qag vector result");
+    t.test_rel(err2,err1,1.0e-15,"qag vector error");
+  }
   
   /* Test adaptive integration \ref o2scl::inte_qag_gsl the standard
      oscillatory integrand from the QUADPACK test-battery [\ref
@@ -57,6 +57,9 @@ namespace o2scl {
   /// The lower limit
   double lower_limit;
 
+  /// Transformed abscissas for vectorized functions
+  std::vector<double> x_tr;
+
 #endif
       
   public:
@@ -72,6 +75,18 @@ namespace o2scl {
     return this->qags(func,0.0,1.0,this->tol_abs,this->tol_rel,&res,&err);
   }
 
+  /** \brief Integrate a vectorized function over the interval 
+      \f$ [a, \infty) \f$ giving result \c res and error \c err
+
+      The value \c b is ignored. See \ref
+      inte_qag_gsl::integ_err_vec() .
+  */
+  virtual int integ_err_vec(funct_vec &func, double a, double b, 
+			    double &res, double &err) {
+    lower_limit=a;
+    return this->qags(func,0.0,1.0,this->tol_abs,this->tol_rel,&res,&err);
+  }
+
 #ifndef DOXYGEN_INTERNAL
 
   protected:
@@ -83,6 +98,20 @@ namespace o2scl {
     return y/t/t;
   }
 
+  /// Transform to \f$ t \in (0,1] \f$ for vectorized functions
+  virtual void transform_vec(size_t n, const double *t, double *y,
+			     funct_vec &func) {
+    if (x_tr.size()<n) x_tr.resize(n);
+    for(size_t i=0;i<n;i++) {
+      x_tr[i]=lower_limit+(1-t[i])/t[i];
+    }
+    func(n,&(x_tr[0]),y);
+    for(size_t i=0;i<n;i++) {
+      y[i]=y[i]/t[i]/t[i];
+    }
+    return;
+  }
+
 #endif
       
   };
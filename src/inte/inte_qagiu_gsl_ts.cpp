@@ -39,6 +39,13 @@ double sin_recip(double x) {
   return sin(1.0/(x+0.01))*pow(x+0.01,-2.0);
 }
 
+void sin_recip_vec(size_t n, const double *x, double *y) {
+  for(size_t i=0;i<n;i++) {
+    y[i]=sin(1.0/(x[i]+0.01))*pow(x[i]+0.01,-2.0);
+  }
+  return;
+}
+
 double f(double x, void *params) {
   double f=sin(1.0/(x+0.01))*pow(x+0.01,-2.0);
   return f;
@@ -107,6 +114,16 @@ int main(void) {
   ans=it.integ(tf2,0.0,0.0);
   t.test_rel(ans,exact,1.0e-8,"qagiu test 2");
 
+  // Make sure the vectorized integrand gives the same result
+  {
+    funct_vec tf2_vec=sin_recip_vec;
+    double res1, err1, res2, err2;
+    it.integ_err(tf2,0.0,0.0,res1,err1);
+    it.integ_err_vec(tf2_vec,0.0,0.0,res2,err2);
+    t.test_rel(res2,res1,1.0e-15,"qagiu vector result");
+    t.test_rel(err2,err1,1.0e-15,"qagiu vector error");
+  }
+
   {
     gsl_integration_workspace *w=gsl_integration_workspace_alloc(1000);
     
@@ -71,6 +71,16 @@ namespace o2scl {
 			double &res, double &err) {
     return this->qags(func,a,b,this->tol_abs,this->tol_rel,&res,&err);
   }
+
+  /** \brief Integrate the vectorized function \c func from \c a to
+      \c b and place the result in \c res and the error in \c err
+
+      See \ref inte_qag_gsl::integ_err_vec() .
+  */
+  virtual int integ_err_vec(funct_vec &func, double a, double b, 
+			    double &res, double &err) {
+    return this->qags(func,a,b,this->tol_abs,this->tol_rel,&res,&err);
+  }
            
   };
   
@@ -34,6 +34,14 @@ double log_over_sqrt(double x,double &alpha) {
   return f;
 }
 
+void log_over_sqrt_vec(size_t n, const double *x, double *y,
+		       double &alpha) {
+  for(size_t i=0;i<n;i++) {
+    y[i]=log(alpha*x[i])/sqrt(x[i]);
+  }
+  return;
+}
+
 double log_over_sqrt_gsl(double x,void *params) {
   double alpha=*(double *)params;
   return log(alpha*x)/sqrt(x);
@@ -92,6 +100,18 @@ int main(void) {
     
     gsl_integration_workspace_free(w);
   }
+
+  // Make sure the vectorized integrand gives the same result
+  {
+    funct_vec tf3_vec=std::bind(log_over_sqrt_vec,std::placeholders::_1,
+				std::placeholders::_2,std::placeholders::_3,
+				alf);
+    double res1, err1, res2, err2;
+    it.integ_err(tf3,0.0,1.0,res1,err1);
+    it.integ_err_vec(tf3_vec,0.0,1.0,res2,err2);
+    t.test_rel(res2,res1,1.0e-15,"qags vector result");
+    t.test_rel(err2,err1,1.0e-15,"qags vector error");
+  }
   
   /*
     Test adaptive integration \ref o2scl::inte_qag_gsl against the
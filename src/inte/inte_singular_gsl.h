@@ -345,7 +345,8 @@ namespace o2scl {
         \future Remove goto statements. Before this is done, it might
 	be best to add some tests which fail in the various ways.
     */
-    int qags(func_t &func, const double a, const double b,
+    template<class func2_t>
+    int qags(func2_t &func, const double a, const double b,
 	     const double l_epsabs, const double l_epsrel,
 	     double *result, double *abserr) {
       
@@ -392,7 +393,8 @@ namespace o2scl {
       
       /* Perform the first integration */
       
-      this->gauss_kronrod(func,a,b,&result0,&abserr0,&resabs0,&resasc0);
+      this->gauss_kronrod_list(func,1,&a,&b,&result0,&abserr0,
+			       &resabs0,&resasc0);
       
       this->w->set_initial_result (result0, abserr0);
 	  
@@ -469,6 +471,8 @@ namespace o2scl {
 	double error1 = 0, error2 = 0, error12 = 0;
 	double resasc1, resasc2;
 	double resabs1, resabs2;
+	double a12[2], b12[2], area_v[2], error_v[2];
+	double resasc_v[2], resabs_v[2];
 	double last_e_i;
 	    
 	/* Bisect the subinterval with the largest error estimate */
@@ -484,8 +488,20 @@ namespace o2scl {
 	    
 	iteration++;
 	
-	this->gauss_kronrod(func,a1,b1,&area1,&error1,&resabs1,&resasc1);
-	this->gauss_kronrod(func,a2,b2,&area2,&error2,&resabs2,&resasc2);
+	a12[0]=a1;
+	b12[0]=b1;
+	a12[1]=a2;
+	b12[1]=b2;
+	this->gauss_kronrod_list(func,2,a12,b12,area_v,error_v,
+				 resabs_v,resasc_v);
+	area1=area_v[0];
+	error1=error_v[0];
+	resabs1=resabs_v[0];
+	resasc1=resasc_v[0];
+	area2=area_v[1];
+	error2=error_v[1];
+	resabs2=resabs_v[1];
+	resasc2=resasc_v[1];
 	
 	area12 = area1 + area2;
 	error12 = error1 + error2;
@@ -769,6 +785,35 @@ namespace o2scl {
       (fmp,a,b,result,abserr,resabs,resasc);
   }
 
+  /** \brief The transformation to apply to a vectorized
+      user-supplied function
+
+      This function should compute the transformed integrand at the
+      \c n points in \c t and store the results in \c y. The
+      default version calls the error handler.
+  */
+  virtual void transform_vec(size_t n, const double *t, double *y,
+			     funct_vec &func) {
+    O2SCL_ERR2("Vectorized functions not supported in ",
+	       "inte_transform_gsl::transform_vec().",exc_eunimpl);
+    return;
+  }
+  
+  /** \brief Integration wrapper for internal transformed 
+      vectorized function type
+  */
+  virtual void gauss_kronrod_vec
+  (funct_vec &func, size_t n, const double *a, const double *b,
+   double *result, double *abserr, double *resabs, double *resasc) {
+
+    funct_vec fmp=[this,&func](size_t m, const double *t, double *y) {
+      this->transform_vec(m,t,y,func);
+    };
+    
+    return this->gauss_kronrod_vec_base
+      (fmp,n,a,b,result,abserr,resabs,resasc);
+  }
+
   };
 
 #ifndef DOXYGEN_NO_O2NS
@@ -29,6 +29,11 @@
 
 #include <iostream>
 #include <random>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 
 #ifdef O2SCL_OPENMP
 #include <omp.h>
@@ -1992,6 +1997,363 @@ namespace o2scl {
       and set back to <tt>false</tt> after mcmc_init() is called.
   */
   bool prev_read;
+
+  /** \brief A snapshot of the data for one append to the 
+      output file
+  */
+  class append_job {
+  public:
+    /// \name Copies of the acceptance and rejection counts
+    //@{
+    std::vector<size_t> n_accept;
+    std::vector<size_t> n_reject;
+    std::vector<std::vector<size_t> > ret_value_counts;
+    std::vector<ubvector> initial_points;
+    //@}
+    /// If true, write the column names, units, and constants
+    bool structure;
+    /// The column names
+    std::vector<std::string> col_names;
+    /// \name The table structure (only set if \ref structure is true)
+    //@{
+    std::vector<std::string> units;
+    std::vector<std::string> con_names;
+    std::vector<double> con_values;
+    size_t itype;
+    //@}
+    /// The first new row
+    size_t start;
+    /// The number of rows in the file after this job
+    size_t nlines;
+    /// The new rows for each column
+    std::vector<std::vector<double> > cols;
+    /// If true, close the file after writing
+    bool close;
+  };
+
+  /** \brief The state of the asynchronous writer thread
+   */
+  class async_writer {
+  public:
+    /// The writer thread
+    std::thread thread;
+    /// Mutex protecting the queue
+    std::mutex mutex;
+    /// Signals a change in the queue
+    std::condition_variable cv;
+    /// Queued jobs
+    std::deque<std::shared_ptr<append_job> > queue;
+    /// Maximum number of queued jobs
+    size_t max_jobs;
+    /// If true, the thread exits once the queue is empty
+    bool stop;
+    /// An exception thrown in the writer thread
+    std::exception_ptr error;
+
+    /// Stop the thread after the queue is empty
+    void finish() {
+      {
+	std::unique_lock<std::mutex> lk(mutex);
+	stop=true;
+      }
+      cv.notify_all();
+      if (thread.joinable()) thread.join();
+      return;
+    }
+    
+    ~async_writer() {
+      finish();
+    }
+  };
+  
+  /// \name Data for appending to the output file
+  //@{
+  /// The output file, kept open between updates in append mode
+  std::shared_ptr<o2scl_hdf::hdf_file> hf_append;
+
+  /// The number of table rows already written to \ref hf_append
+  size_t append_nlines;
+
+  /** \brief If true, write all the table rows at the next update
+      and close the file (set by \ref mcmc_cleanup() )
+  */
+  bool append_all;
+
+  /// The writer thread (only used if \ref file_async is true)
+  std::shared_ptr<async_writer> writer;
+  //@}
+
+  /** \brief Write the run parameters which do not change 
+      during the simulation
+  */
+  virtual void write_params(o2scl_hdf::hdf_file &hf) {
+    hf.setd("ai_initial_step",this->ai_initial_step);
+    hf.seti("aff_inv",this->aff_inv);
+    hf.seti("always_accept",this->always_accept);
+    hf.setd_vec_copy("high",this->high_copy);
+    hf.setd_vec_copy("low",this->low_copy);
+    hf.set_szt("max_bad_steps",this->max_bad_steps);
+    hf.set_szt("max_iters",this->max_iters);
+    hf.set_szt("max_time",this->max_time);
+    hf.set_szt("file_update_iters",this->file_update_iters);
+    hf.set_szt("file_update_time",this->file_update_time);
+    hf.seti("mpi_rank",this->mpi_rank);
+    hf.seti("mpi_size",this->mpi_size);
+    hf.set_szt("n_params",this->n_params);
+    hf.set_szt("n_threads",this->n_threads);
+    hf.set_szt("n_walk",this->n_walk);
+    hf.set_szt("n_warm_up",this->n_warm_up);
+    hf.seti("pd_mode",this->pd_mode);
+    hf.sets("prefix",this->prefix);
+    hf.setd("step_fac",this->step_fac);
+    hf.seti("store_rejects",this->store_rejects);
+    hf.seti("table_sequence",this->table_sequence);
+    hf.seti("user_seed",this->user_seed);
+    hf.seti("verbose",this->verbose);
+    file_header(hf);
+    return;
+  }
+
+  /** \brief Write the acceptance and rejection counts and
+      the initial points
+  */
+  void write_status(o2scl_hdf::hdf_file &hf,
+		    const std::vector<size_t> &n_acc,
+		    const std::vector<size_t> &n_rej,
+		    const std::vector<std::vector<size_t> > &rvc,
+		    const std::vector<ubvector> &ip) {
+    hf.set_szt_vec("n_accept",n_acc);
+    hf.set_szt_vec("n_reject",n_rej);
+    if (rvc.size()>0) {
+      hf.set_szt_arr2d_copy("ret_value_counts",rvc.size(),
+			    rvc[0].size(),rvc);
+    }
+    hf.setd_arr2d_copy("initial_points",ip.size(),ip[0].size(),ip);
+    return;
+  }
+
+  /** \brief Create a snapshot of the rows of the table which will
+      no longer change
+
+      A row can only be modified by the MCMC after it is written if
+      it is the most recent acceptance of some walker (its
+      multiplier may be incremented) or if it is at or past that
+      point in the table (it may be filled later). Thus all rows
+      before the smallest entry in \ref walker_accept_rows are
+      final, and only those rows are copied, unless \ref
+      append_all is true. 
+  */
+  virtual void prepare_append(append_job &job) {
+    
+    job.n_accept=this->n_accept;
+    job.n_reject=this->n_reject;
+    job.ret_value_counts=this->ret_value_counts;
+    job.initial_points=this->initial_points;
+    
+    // Determine the number of final rows
+    size_t n_final=table->get_nlines();
+    if (append_all==false) {
+      for(size_t i=0;i<walker_accept_rows.size();i++) {
+	if (walker_accept_rows[i]<0) {
+	  n_final=0;
+	} else if (((size_t)walker_accept_rows[i])<n_final) {
+	  n_final=walker_accept_rows[i];
+	}
+      }
+    }
+    if (n_final<append_nlines) n_final=append_nlines;
+
+    // The table structure is written only once
+    job.structure=(append_nlines==0);
+    if (job.structure) {
+      for(size_t i=0;i<table->get_nconsts();i++) {
+	std::string name;
+	double val;
+	table->get_constant(i,name,val);
+	job.con_names.push_back(name);
+	job.con_values.push_back(val);
+      }
+      for(size_t i=0;i<table->get_ncolumns();i++) {
+	job.units.push_back(table->get_unit(table->get_column_name(i)));
+      }
+      job.itype=table->get_interp_type();
+    }
+
+    // Copy the new rows of each column
+    job.start=append_nlines;
+    job.nlines=n_final;
+    job.cols.resize(table->get_ncolumns());
+    job.col_names.resize(table->get_ncolumns());
+    for(size_t i=0;i<table->get_ncolumns();i++) {
+      job.col_names[i]=table->get_column_name(i);
+      const std::vector<double> &col=table->get_column(job.col_names[i]);
+      job.cols[i].assign(col.begin()+append_nlines,col.begin()+n_final);
+    }
+    job.close=append_all;
+    
+    if (this->verbose>=2) {
+      this->scr_out << "mcmc: Appending rows " << append_nlines
+		    << " to " << n_final << "." << std::endl;
+    }
+    append_nlines=n_final;
+
+    return;
+  }
+
+  /** \brief Write the snapshot \c job to the output file
+
+      The table is stored in the same format as that produced by
+      \ref o2scl_hdf::hdf_output(), so it can be read with \ref
+      o2scl_hdf::hdf_input() . In asynchronous mode, this function
+      is called from the writer thread, so it must not use any
+      data which the MCMC threads modify.
+  */
+  virtual void write_job(o2scl_hdf::hdf_file &hf, append_job &job) {
+
+    write_status(hf,job.n_accept,job.n_reject,job.ret_value_counts,
+		 job.initial_points);
+    hf.seti("n_tables",1);
+
+    hid_t top=hf.get_current_id();
+    hid_t group=hf.open_group("markov_chain_0");
+    hf.set_current_id(group);
+    
+    if (job.structure) {
+      hf.sets_fixed("o2scl_type","table");
+      hf.sets_vec("con_names",job.con_names);
+      hf.setd_vec("con_values",job.con_values);
+      hf.sets_vec("col_names",job.col_names);
+      hf.seti("unit_flag",1);
+      hf.sets_vec("units",job.units);
+      hf.set_szt("itype",job.itype);
+    }
+
+    // Write the new rows of each column
+    hid_t group2=hf.open_group("data");
+    hf.set_current_id(group2);
+    for(size_t i=0;i<job.cols.size();i++) {
+      hf.setd_arr_extend(job.col_names[i],job.start,
+			 job.nlines-job.start,job.cols[i].data());
+    }
+    hf.close_group(group2);
+    hf.set_current_id(group);
+    
+    hf.seti("nlines",((int)job.nlines));
+    hf.close_group(group);
+    hf.set_current_id(top);
+
+    if (job.close) {
+      hf.close();
+    } else {
+      H5Fflush(hf.get_file_id(),H5F_SCOPE_LOCAL);
+    }
+    
+    return;
+  }
+
+  /** \brief The main loop of the writer thread
+   */
+  void writer_loop(std::shared_ptr<async_writer> w,
+		   std::shared_ptr<o2scl_hdf::hdf_file> hf) {
+    try {
+      while (true) {
+	std::shared_ptr<append_job> job;
+	{
+	  std::unique_lock<std::mutex> lk(w->mutex);
+	  w->cv.wait(lk,[&w]{ return !w->queue.empty() || w->stop; });
+	  if (w->queue.empty()) return;
+	  job=w->queue.front();
+	}
+	write_job(*hf,*job);
+	{
+	  // Remove the job only after it is written, so that 
+	  // the queue bounds the number of outstanding snapshots
+	  std::unique_lock<std::mutex> lk(w->mutex);
+	  w->queue.pop_front();
+	}
+	w->cv.notify_all();
+      }
+    } catch (...) {
+      std::unique_lock<std::mutex> lk(w->mutex);
+      w->error=std::current_exception();
+      w->queue.clear();
+      w->stop=true;
+      lk.unlock();
+      w->cv.notify_all();
+    }
+    return;
+  }
+
+  /** \brief Stop the writer thread, if it is running, and rethrow
+      any exception from that thread
+  */
+  void writer_finish() {
+    if (writer!=0) {
+      std::shared_ptr<async_writer> w=writer;
+      writer.reset();
+      w->finish();
+      if (w->error) std::rethrow_exception(w->error);
+    }
+    return;
+  }
+
+  /** \brief Append the rows of the table which will no longer
+      change to the output file, either directly or by queueing
+      them for the writer thread
+  */
+  virtual void write_append() {
+
+    if (hf_append==0) {
+      std::string fname=this->prefix+"_"+o2scl::itos(this->mpi_rank)+
+	"_out";
+      hf_append=std::shared_ptr<o2scl_hdf::hdf_file>
+	(new o2scl_hdf::hdf_file);
+      hf_append->open_or_create(fname);
+      append_nlines=0;
+    }
+    
+    if (first_write==false) {
+      write_params(*hf_append);
+      first_write=true;
+    }
+
+    std::shared_ptr<append_job> job(new append_job);
+    prepare_append(*job);
+    
+    if (file_async==false) {
+      write_job(*hf_append,*job);
+    } else {
+      
+      if (writer==0) {
+	writer=std::shared_ptr<async_writer>(new async_writer);
+	writer->max_jobs=async_max_jobs>0 ? async_max_jobs : 1;
+	writer->stop=false;
+	writer->thread=std::thread(&mcmc_para_table::writer_loop,this,
+				   writer,hf_append);
+      }
+      
+      {
+	// If the queue is full, wait for the writer to catch up
+	std::unique_lock<std::mutex> lk(writer->mutex);
+	std::shared_ptr<async_writer> w=writer;
+	w->cv.wait(lk,[&w]{ return w->queue.size()<w->max_jobs ||
+	      w->stop; });
+	if (w->stop==false) {
+	  w->queue.push_back(job);
+	}
+      }
+      writer->cv.notify_all();
+    
+    }
+
+    if (append_all) {
+      // Wait for the final job to be written
+      writer_finish();
+      hf_append.reset();
+    }
+    
+    return;
+  }
   
   public:
 
@@ -2022,6 +2384,37 @@ namespace o2scl {
   /** \brief If true, store MCMC rejections in the table
    */
   bool store_rejects;
+
+  /** \brief If true, keep the output file open and append 
+      only the new rows of the table at each file update 
+      (default false)
+
+      When this is false, every file update rewrites the entire
+      table. When this is true, the run parameters are written
+      once and each update only extends the column datasets with
+      the rows which are final (see \ref write_append() ). This
+      mode is not used when \ref table_io_chunk is larger than 1.
+  */
+  bool file_append;
+
+  /** \brief If true, in append mode, write to the file from a
+      separate thread (default false)
+
+      At each file update, a copy of the new rows is handed to a
+      writer thread and the MCMC resumes immediately. If \ref
+      async_max_jobs copies are already waiting to be written,
+      then the MCMC waits for the writer. The final rows are
+      always written and the file is closed before \ref
+      mcmc_cleanup() returns. This requires that the MCMC threads
+      do not use the HDF5 library during the simulation unless
+      HDF5 was built to be thread-safe.
+  */
+  bool file_async;
+
+  /** \brief The maximum number of file updates waiting to be
+      written by the writer thread (default 2)
+  */
+  size_t async_max_jobs;
   //@}
   
   /** \brief Write MCMC tables to files
@@ -2070,60 +2463,36 @@ namespace o2scl {
     }
 #endif
     
-    o2scl_hdf::hdf_file hf;
-    std::string fname=this->prefix+"_"+o2scl::itos(this->mpi_rank)+"_out";
-    hf.open_or_create(fname);
+    if (file_append && table_io_chunk<=1) {
 
-    if (first_write==false) {
-      hf.setd("ai_initial_step",this->ai_initial_step);
-      hf.seti("aff_inv",this->aff_inv);
-      hf.seti("always_accept",this->always_accept);
-      hf.setd_vec_copy("high",this->high_copy);
-      hf.setd_vec_copy("low",this->low_copy);
-      hf.set_szt("max_bad_steps",this->max_bad_steps);
-      hf.set_szt("max_iters",this->max_iters);
-      hf.set_szt("max_time",this->max_time);
-      hf.set_szt("file_update_iters",this->file_update_iters);
-      hf.set_szt("file_update_time",this->file_update_time);
-      hf.seti("mpi_rank",this->mpi_rank);
-      hf.seti("mpi_size",this->mpi_size);
-      hf.set_szt("n_params",this->n_params);
-      hf.set_szt("n_threads",this->n_threads);
-      hf.set_szt("n_walk",this->n_walk);
-      hf.set_szt("n_warm_up",this->n_warm_up);
-      hf.seti("pd_mode",this->pd_mode);
-      hf.sets("prefix",this->prefix);
-      hf.setd("step_fac",this->step_fac);
-      hf.seti("store_rejects",this->store_rejects);
-      hf.seti("table_sequence",this->table_sequence);
-      hf.seti("user_seed",this->user_seed);
-      hf.seti("verbose",this->verbose);
-      file_header(hf);
-      first_write=true;
-    }
-    
-    hf.set_szt_vec("n_accept",this->n_accept);
-    hf.set_szt_vec("n_reject",this->n_reject);
-    if (this->ret_value_counts.size()>0) {
-      hf.set_szt_arr2d_copy("ret_value_counts",this->ret_value_counts.size(),
-			    this->ret_value_counts[0].size(),
-			    this->ret_value_counts);
-    }
-    hf.setd_arr2d_copy("initial_points",this->initial_points.size(),
-		       this->initial_points[0].size(),
-		       this->initial_points);
+      write_append();
+      
+    } else {
+      
+      o2scl_hdf::hdf_file hf;
+      std::string fname=this->prefix+"_"+o2scl::itos(this->mpi_rank)+"_out";
+      hf.open_or_create(fname);
+      
+      if (first_write==false) {
+	write_params(hf);
+	first_write=true;
+      }
+      write_status(hf,this->n_accept,this->n_reject,
+		   this->ret_value_counts,this->initial_points);
+      
+      hf.seti("n_tables",tab_arr.size()+1);
+      if (rank_sent==false) {
+	hdf_output(hf,*table,"markov_chain_0");
+      }
+      for(size_t i=0;i<tab_arr.size();i++) {
+	std::string name=((std::string)"markov_chain_")+szttos(i+1);
+	hdf_output(hf,tab_arr[i],name);
+      }
+      
+      hf.close();
 
-    hf.seti("n_tables",tab_arr.size()+1);
-    if (rank_sent==false) {
-      hdf_output(hf,*table,"markov_chain_0");
-    }
-    for(size_t i=0;i<tab_arr.size();i++) {
-      std::string name=((std::string)"markov_chain_")+szttos(i+1);
-      hdf_output(hf,tab_arr[i],name);
     }
     
-    hf.close();
-    
 #ifdef O2SCL_MPI
     if (sync_write && this->mpi_size>1 &&
 	this->mpi_rank<this->mpi_size-1) {
@@ -2148,6 +2517,11 @@ namespace o2scl {
     table_sequence=true;
     prev_read=false;
     table_prealloc=0;
+    file_append=false;
+    append_nlines=0;
+    append_all=false;
+    file_async=false;
+    async_max_jobs=2;
   }
   
   /// \name Basic usage
@@ -2464,6 +2838,14 @@ namespace o2scl {
     high_copy=high;
     
     first_write=false;
+
+    // Close the output file if it was left open by a previous
+    // run which did not finish
+    writer_finish();
+    if (hf_append!=0) {
+      hf_append.reset();
+    }
+    append_nlines=0;
     
     // Set number of threads (this is done in the child as well, but
     // we need this number to set up the vector of measure functions
@@ -2874,7 +3256,9 @@ namespace o2scl {
       table->set_nlines(i+2);
     }
 
+    append_all=true;
     write_files(true);
+    append_all=false;
 
     return parent_t::mcmc_cleanup();
   }
@@ -3035,6 +3419,8 @@ namespace o2scl {
   o2scl::cli::parameter_bool p_aff_inv;
   o2scl::cli::parameter_bool p_table_sequence;
   o2scl::cli::parameter_bool p_store_rejects;
+  o2scl::cli::parameter_bool p_file_append;
+  o2scl::cli::parameter_bool p_file_async;
   o2scl::cli::parameter_double p_max_time;
   o2scl::cli::parameter_size_t p_max_iters;
   //o2scl::cli::parameter_int p_max_chain_size;
@@ -3187,6 +3573,17 @@ namespace o2scl {
       "(default false).";
     cl.par_list.insert(std::make_pair("store_rejects",&p_store_rejects));
     
+    p_file_append.b=&this->file_append;
+    p_file_append.help=((std::string)"If true, then keep the output file ")+
+      "open and append only new rows at each update (default false).";
+    cl.par_list.insert(std::make_pair("file_append",&p_file_append));
+
+    p_file_async.b=&this->file_async;
+    p_file_async.help=((std::string)"If true and file_append is true, ")+
+      "then write to the output file from a separate thread "+
+      "(default false).";
+    cl.par_list.insert(std::make_pair("file_async",&p_file_async));
+    
     return;
   }
   
@@ -563,6 +563,55 @@ int main(int argc, char *argv[]) {
     }
     cout << endl;
   }
+
+  for(size_t k=0;k<2;k++) {
+    // ----------------------------------------------------------------
+    // Affine-invariant MCMC with a table appended to the file,
+    // first synchronously and then with the writer thread
+  
+    cout << "Affine-invariant MCMC with a table appended to the file: "
+	 << endl;
+  
+    mpc.mct.aff_inv=true;
+    mpc.mct.n_walk=10;
+    mpc.mct.step_fac=-1.0;
+    mpc.mct.verbose=1;
+    mpc.mct.max_iters=200;
+    mpc.mct.prefix="mcmct_append";
+    mpc.mct.file_append=true;
+    mpc.mct.file_async=(k==1);
+    mpc.mct.file_update_iters=20;
+    mpc.mct.store_rejects=true;
+    
+    mpc.mct.mcmc(1,low,high,gauss_vec,fill_vec);
+    
+    // The file should contain exactly the final table
+    table=mpc.mct.get_table();
+    table_units<> tab_file;
+    hdf_file hf;
+    hf.open("mcmct_append_0_out");
+    string tname;
+    hdf_input(hf,tab_file,tname);
+    hf.close();
+    tm.test_gen(tab_file.get_nlines()==table->get_nlines(),
+		"append nlines");
+    tm.test_gen(tab_file.get_ncolumns()==table->get_ncolumns(),
+		"append ncolumns");
+    tm.test_gen(tab_file.get_unit("x")=="MeV","append unit");
+    for(size_t j=0;j<table->get_ncolumns();j++) {
+      const std::vector<double> &c1=table->get_column
+	(table->get_column_name(j));
+      const std::vector<double> &c2=tab_file.get_column
+	(table->get_column_name(j));
+      tm.test_rel_vec(table->get_nlines(),c1,c2,1.0e-15,"append data");
+    }
+    
+    mpc.mct.file_append=false;
+    mpc.mct.file_async=false;
+    mpc.mct.file_update_iters=0;
+    mpc.mct.store_rejects=false;
+    cout << endl;
+  }
   
   tm.report();
   
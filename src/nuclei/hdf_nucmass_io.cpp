@@ -98,7 +98,7 @@ void o2scl_hdf::ame_load_ext(o2scl::nucmass_ame &ame, std::string file_name,
   ame.n=nrecords;
   ame.mass=m;
   ame.reference=reference;
-  ame.last=nrecords/2;
+  ame.index_build_entries(ame.n,ame.mass);
     
   if (exp_only) {
 
@@ -119,7 +119,7 @@ void o2scl_hdf::ame_load_ext(o2scl::nucmass_ame &ame, std::string file_name,
     ame.n=n_exp;
     ame.mass=m2;
     ame.reference=reference;
-    ame.last=n_exp/2;
+    ame.index_build_entries(ame.n,ame.mass);
   }
       
   hf.close();
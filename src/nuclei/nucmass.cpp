@@ -286,6 +286,17 @@ double nucmass_semi_empirical::mass_excess_d(double Z, double N) {
   return ret;
 }
 
+void nucmass_semi_empirical::mass_excess_list(size_t nn,
+					      const std::vector<int> &vZ,
+					      const std::vector<int> &vN,
+					      std::vector<double> &mex) {
+  // Call mass_excess_d() non-virtually so that it can be inlined
+  for(size_t i=0;i<nn;i++) {
+    mex[i]=nucmass_semi_empirical::mass_excess_d(vZ[i],vN[i]);
+  }
+  return;
+}
+
 int nucmass_semi_empirical::fit_fun(size_t nv, const ubvector &x) {
   B=-x[0]; Sv=x[1]; Ss=x[2]; Ec=x[3]; Epair=x[4];
   return 0;
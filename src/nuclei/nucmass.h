@@ -30,6 +30,7 @@
 #include <cmath>
 #include <string>
 #include <map>
+#include <vector>
 
 #include <boost/numeric/ublas/vector.hpp>
 
@@ -263,6 +264,37 @@ namespace o2scl {
     virtual double binding_energy_d(double Z, double N) {
       return (mass_excess_d(Z,N)+((Z+N)*m_amu-Z*m_elec-N*m_neut-Z*m_prot));
     }
+
+    /** \brief Compute the mass excesses in MeV of the first \c nn 
+	nuclei in \c Z and \c N and store them in \c mex
+
+	The default implementation calls \ref mass_excess() for each
+	nucleus. Descendants which can compute many nuclei at once
+	more efficiently may override this function.
+    */
+    virtual void mass_excess_list(size_t nn, const std::vector<int> &Z,
+				  const std::vector<int> &N,
+				  std::vector<double> &mex) {
+      for(size_t i=0;i<nn;i++) {
+	mex[i]=mass_excess(Z[i],N[i]);
+      }
+      return;
+    }
+    
+    /** \brief Compute the binding energies in MeV of the first \c nn 
+	nuclei in \c Z and \c N and store them in \c be
+
+	The default implementation calls \ref binding_energy() for
+	each nucleus.
+    */
+    virtual void binding_energy_list(size_t nn, const std::vector<int> &Z,
+				     const std::vector<int> &N,
+				     std::vector<double> &be) {
+      for(size_t i=0;i<nn;i++) {
+	be[i]=binding_energy(Z[i],N[i]);
+      }
+      return;
+    }
     
     /** \brief Return the total mass of the nucleus (without the
 	electrons) in MeV
@@ -325,16 +357,99 @@ namespace o2scl {
       Generally, descendants of this class only need to provide an
       implementation of \ref mass_excess() and possibly a version
       of \ref nucmass::is_included()
-      
+
+      Descendants should call \ref index_build() after loading the
+      data so that \ref index_find() can locate the table entry for
+      any nucleus in constant time.
   */
   class nucmass_table : public nucmass {
 
   protected:
+
+    /// \name Dense index of the table entries
+    //@{
+    /// The smallest value of Z in the table
+    int ix_Zmin;
+    /// The smallest value of N in the table
+    int ix_Nmin;
+    /// The number of values of Z spanned by the index
+    int ix_nZ;
+    /// The number of values of N spanned by the index
+    int ix_nN;
+    /** \brief The table entry for each (Z,N), stored as
+	<tt>(Z-ix_Zmin)*ix_nN+N-ix_Nmin</tt>, or -1 if absent
+    */
+    std::vector<int> ix_row;
+
+    /** \brief Construct the index from the first \c nent
+	values of \c vZ and \c vN
+
+	If a nucleus appears more than once, the last entry is
+	used.
+    */
+    template<class vec_t, class vec2_t>
+      void index_build(size_t nent, const vec_t &vZ, const vec2_t &vN) {
+      ix_row.clear();
+      ix_nZ=0;
+      ix_nN=0;
+      if (nent==0) return;
+      int Zmax, Nmax;
+      ix_Zmin=((int)vZ[0]);
+      ix_Nmin=((int)vN[0]);
+      Zmax=ix_Zmin;
+      Nmax=ix_Nmin;
+      for(size_t i=1;i<nent;i++) {
+	int Z=((int)vZ[i]), N=((int)vN[i]);
+	if (Z<ix_Zmin) ix_Zmin=Z;
+	if (Z>Zmax) Zmax=Z;
+	if (N<ix_Nmin) ix_Nmin=N;
+	if (N>Nmax) Nmax=N;
+      }
+      ix_nZ=Zmax-ix_Zmin+1;
+      ix_nN=Nmax-ix_Nmin+1;
+      ix_row.resize(ix_nZ*ix_nN,-1);
+      for(size_t i=0;i<nent;i++) {
+	ix_row[(((int)vZ[i])-ix_Zmin)*ix_nN+((int)vN[i])-ix_Nmin]=
+	  ((int)i);
+      }
+      return;
+    }
+
+    /** \brief Construct the index from the first \c nent
+	entries of the array \c ent
+
+	The type <tt>entry_t</tt> must have integer members 
+	named \c Z and \c N.
+    */
+    template<class entry_t>
+      void index_build_entries(size_t nent, const entry_t *ent) {
+      std::vector<int> vZ(nent), vN(nent);
+      for(size_t i=0;i<nent;i++) {
+	vZ[i]=ent[i].Z;
+	vN[i]=ent[i].N;
+      }
+      index_build(nent,vZ,vN);
+      return;
+    }
+
+    /** \brief Return the table entry for the nucleus with
+	\c Z protons and \c N neutrons, or -1 if it is not present
+    */
+    int index_find(int Z, int N) const {
+      int iZ=Z-ix_Zmin, iN=N-ix_Nmin;
+      if (iZ<0 || iN<0 || iZ>=ix_nZ || iN>=ix_nN) return -1;
+      return ix_row[iZ*ix_nN+iN];
+    }
+    //@}
     
   public:
 
     nucmass_table() {
       n=0;
+      ix_Zmin=0;
+      ix_Nmin=0;
+      ix_nZ=0;
+      ix_nN=0;
     }
     
     /// The number of entries
@@ -458,6 +573,13 @@ namespace o2scl {
       return mass_excess_d(Z,N);
     }
 
+    /** \brief Compute the mass excesses in MeV of the first \c nn 
+	nuclei in \c Z and \c N and store them in \c mex
+    */
+    virtual void mass_excess_list(size_t nn, const std::vector<int> &Z,
+				  const std::vector<int> &N,
+				  std::vector<double> &mex);
+
     /// Fix parameters from an array for fitting
     virtual int fit_fun(size_t nv, const ubvector &x);
 
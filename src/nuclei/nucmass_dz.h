@@ -76,9 +76,6 @@ namespace o2scl {
     /// Table containing the data
     table<> data;
 
-    /// The last table index for caching
-    int last;
-
 #endif
     
   };
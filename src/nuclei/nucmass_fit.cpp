@@ -26,6 +26,10 @@
 
 #include <o2scl/nucmass_fit.h>
 
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
@@ -44,10 +48,16 @@ nucmass_fit::nucmass_fit() {
 double nucmass_fit::min_fun(size_t nv, const ubvector &x) {
 
   double y=0.0;
-  
-  nmf->fit_fun(nv,x);
-  
-  eval(*nmf,y);
+
+  if (nmf_thr.size()>0) {
+    for(size_t i=0;i<nmf_thr.size();i++) {
+      nmf_thr[i]->fit_fun(nv,x);
+    }
+    eval_para(nm_thr,y);
+  } else {
+    nmf->fit_fun(nv,x);
+    eval(*nmf,y);
+  }
   
   return y;
 }
@@ -60,6 +70,41 @@ void nucmass_fit::fit(nucmass_fit_base &n, double &fmin) {
   }
 
   nmf=&n;
+  nmf_thr.clear();
+  nm_thr.clear();
+  
+  size_t nv=nmf->nfit;
+  ubvector mx(nv);
+  nmf->guess_fun(nv,mx);
+  
+  multi_funct mfm=
+    std::bind(std::mem_fn<double(size_t,const ubvector &)>
+	      (&nucmass_fit::min_fun),
+	      this,std::placeholders::_1,std::placeholders::_2);
+  
+  mm->mmin(nv,mx,fmin,mfm);
+  fmin=mfm(nv,mx);
+
+  return;
+}
+
+void nucmass_fit::fit_para(std::vector<nucmass_fit_base *> &nthr,
+			   double &fmin) {
+  
+  if (dist.size()==0) {
+    O2SCL_ERR2("No experimental masses to fit to in ",
+	       "nucmass_fit::fit_para().",exc_efailed);
+  }
+  if (nthr.size()==0) {
+    O2SCL_ERR("No mass formulas given in nucmass_fit::fit_para().",
+	      exc_einval);
+  }
+
+  nmf=nthr[0];
+  nmf_thr=nthr;
+  nm_thr.resize(nthr.size());
+  for(size_t i=0;i<nthr.size();i++) nm_thr[i]=nthr[i];
+  
   size_t nv=nmf->nfit;
   ubvector mx(nv);
   nmf->guess_fun(nv,mx);
@@ -72,10 +117,20 @@ void nucmass_fit::fit(nucmass_fit_base &n, double &fmin) {
   mm->mmin(nv,mx,fmin,mfm);
   fmin=mfm(nv,mx);
 
+  nmf_thr.clear();
+  nm_thr.clear();
+  
   return;
 }
 
 void nucmass_fit::eval(nucmass &n, double &fmin) {
+  std::vector<nucmass *> nthr(1);
+  nthr[0]=&n;
+  eval_para(nthr,fmin);
+  return;
+}
+
+void nucmass_fit::eval_para(std::vector<nucmass *> &nthr, double &fmin) {
 
   fmin=0.0;
 
@@ -83,83 +138,94 @@ void nucmass_fit::eval(nucmass &n, double &fmin) {
     O2SCL_ERR("No experimental masses to fit to in nucmass_fit::eval().",
 	      exc_efailed);
   }
+  if (nthr.size()==0) {
+    O2SCL_ERR("No mass formulas given in nucmass_fit::eval_para().",
+	      exc_einval);
+  }
+  if (fit_method!=rms_mass_excess && fit_method!=rms_binding_energy &&
+      fit_method!=chi_squared_me && fit_method!=chi_squared_be) {
+    O2SCL_ERR("Unknown fit method in nucmass_fit::eval().",exc_einval);
+  }
+  
+  bool use_be=(fit_method==rms_binding_energy ||
+	       fit_method==chi_squared_be);
 
-  if (fit_method==rms_mass_excess) {
-
-    size_t nn=0;
-    for(vector<nucleus>::iterator ndi=dist.begin();ndi!=dist.end();ndi++) {
-      int Z=ndi->Z;
-      int N=ndi->N;
-      if (N>=minN && Z>=minZ && (even_even==false || (N%2==0 && Z%2==0))) {
-	fmin+=pow(ndi->mex*hc_mev_fm-n.mass_excess(Z,N),2.0);
-	if (!std::isfinite(fmin)) {
-	  std::string s=((std::string)"Non-finite value for nucleus with Z=")+
-	    itos(Z)+" and N="+itos(N)+" in nucmass_fit::eval() (1).";
-	  O2SCL_ERR(s.c_str(),exc_efailed);
-	}
-	nn++;
+  // Select the nuclei to fit
+  if (sel_Z.size()<dist.size()) {
+    sel_Z.resize(dist.size());
+    sel_N.resize(dist.size());
+    sel_exp.resize(dist.size());
+    sel_th.resize(dist.size());
+  }
+  size_t nn=0;
+  for(vector<nucleus>::iterator ndi=dist.begin();ndi!=dist.end();ndi++) {
+    int Z=ndi->Z;
+    int N=ndi->N;
+    if (N>=minN && Z>=minZ && (even_even==false || (N%2==0 && Z%2==0))) {
+      sel_Z[nn]=Z;
+      sel_N[nn]=N;
+      if (use_be) {
+	sel_exp[nn]=ndi->be*hc_mev_fm;
+      } else {
+	sel_exp[nn]=ndi->mex*hc_mev_fm;
       }
+      nn++;
     }
-    fmin=sqrt(fmin/nn);
-
-  } else if (fit_method==rms_binding_energy) {
+  }
 
-    size_t nn=0;
-    for(vector<nucleus>::iterator ndi=dist.begin();ndi!=dist.end();ndi++) {
-      int Z=ndi->Z;
-      int N=ndi->N;
-      if (N>=minN && Z>=minZ && (even_even==false || (N%2==0 && Z%2==0))) {
-	fmin+=pow(ndi->be*hc_mev_fm-n.binding_energy(Z,N),2.0);
-	if (!std::isfinite(fmin)) {
-	  std::string s=((std::string)"Non-finite value for nucleus with Z=")+
-	    itos(Z)+" and N="+itos(N)+" in nucmass_fit::eval() (2).";
-	  O2SCL_ERR(s.c_str(),exc_efailed);
-	}
-	nn++;
+  // Compute the theoretical values
+#ifdef O2SCL_OPENMP
+  if (nthr.size()>1) {
+    int n_threads=((int)nthr.size());
+    err_para_store eps(nn);
+#pragma omp parallel default(shared) num_threads(n_threads)
+    {
+      nucmass *np=nthr[omp_get_thread_num()];
+#pragma omp for schedule(static)
+      for(size_t i=0;i<nn;i++) {
+	eps.run(i,[&]() {
+	    if (use_be) {
+	      sel_th[i]=np->binding_energy(sel_Z[i],sel_N[i]);
+	    } else {
+	      sel_th[i]=np->mass_excess(sel_Z[i],sel_N[i]);
+	    }
+	  });
       }
     }
-    fmin=sqrt(fmin/nn);
-    
-  } else if (fit_method==chi_squared_me) {
-
-    size_t unc_ix=0;
-    for(vector<nucleus>::iterator ndi=dist.begin();ndi!=dist.end();ndi++) {
-      int Z=ndi->Z;
-      int N=ndi->N;
-      if (N>=minN && Z>=minZ && (even_even==false || (N%2==0 && Z%2==0))) {
-	if (unc_ix>=uncs.size()) unc_ix=0;
-	fmin+=pow((ndi->mex*hc_mev_fm-n.mass_excess(Z,N))/
-		  (uncs[unc_ix]),2.0);
-	if (!std::isfinite(fmin)) {
-	  std::string s=((std::string)"Non-finite value for nucleus with Z=")+
-	    itos(Z)+" and N="+itos(N)+" in nucmass_fit::eval() (3).";
-	  O2SCL_ERR(s.c_str(),exc_efailed);
-	}
-	unc_ix++;
-      }
+    // End of parallel region
+    eps.rethrow();
+  } else {
+#endif
+    if (use_be) {
+      nthr[0]->binding_energy_list(nn,sel_Z,sel_N,sel_th);
+    } else {
+      nthr[0]->mass_excess_list(nn,sel_Z,sel_N,sel_th);
     }
+#ifdef O2SCL_OPENMP
+  }
+#endif
 
-  } else if (fit_method==chi_squared_be) {
-
-    size_t unc_ix=0;
-    for(vector<nucleus>::iterator ndi=dist.begin();ndi!=dist.end();ndi++) {
-      int Z=ndi->Z;
-      int N=ndi->N;
-      if (N>=minN && Z>=minZ && (even_even==false || (N%2==0 && Z%2==0))) {
-	if (unc_ix>=uncs.size()) unc_ix=0;
-	fmin+=pow((ndi->be*hc_mev_fm-n.binding_energy(Z,N))/
-		  (uncs[unc_ix]),2.0);
-	if (!std::isfinite(fmin)) {
-	  std::string s=((std::string)"Non-finite value for nucleus with Z=")+
-	    itos(Z)+" and N="+itos(N)+" in nucmass_fit::eval() (4).";
-	  O2SCL_ERR(s.c_str(),exc_efailed);
-	}
-	unc_ix++;
-      }
+  // Sum the contributions serially so that the result does not
+  // depend on the number of threads
+  size_t unc_ix=0;
+  for(size_t i=0;i<nn;i++) {
+    if (fit_method==rms_mass_excess || fit_method==rms_binding_energy) {
+      fmin+=pow(sel_exp[i]-sel_th[i],2.0);
+    } else {
+      if (unc_ix>=uncs.size()) unc_ix=0;
+      fmin+=pow((sel_exp[i]-sel_th[i])/(uncs[unc_ix]),2.0);
+      unc_ix++;
     }
-
-  } else {
-    O2SCL_ERR("Unknown fit method in nucmass_fit::eval().",exc_einval);
+    if (!std::isfinite(fmin)) {
+      std::string s=((std::string)"Non-finite value for nucleus with Z=")+
+	itos(sel_Z[i])+" and N="+itos(sel_N[i])+" in nucmass_fit::eval() ("+
+	itos(fit_method+1)+").";
+      O2SCL_ERR(s.c_str(),exc_efailed);
+    }
+  }
+  
+  if (fit_method==rms_mass_excess || fit_method==rms_binding_energy) {
+    fmin=sqrt(fmin/nn);
   }
     
   return;
@@ -46,6 +46,11 @@ namespace o2scl {
       There is an example of the usage of this class given in 
       \ref ex_nucmass_fit_sect.
 
+      The functions \ref fit_para() and \ref eval_para() compute
+      the mass formula for the selected nuclei in parallel with
+      OpenMP, using one copy of the mass formula for each thread.
+      The copies are supplied by the user, as in \ref mcmc_para_base.
+
       \future Convert to a real fit with errors and covariance, etc.
    */
   class nucmass_fit {
@@ -90,6 +95,32 @@ namespace o2scl {
      */
     virtual void eval(nucmass &n, double &res);
 
+    /** \brief Fit the nuclear mass formula using one copy of the
+	formula for each OpenMP thread
+
+	The vector \c nthr should contain pointers to distinct
+	objects of the same type with identical parameters, and the
+	number of threads is taken to be the size of \c nthr. All
+	of the objects are updated with the parameters of the best
+	fit. The result is identical to that from \ref fit() since
+	the sum over nuclei is always performed serially in the same
+	order.
+    */
+    virtual void fit_para(std::vector<nucmass_fit_base *> &nthr,
+			  double &res);
+    
+    /** \brief Evaluate quality without fitting using one copy of
+	the formula for each OpenMP thread
+
+	If \c nthr has only one element, then the mass excesses or
+	binding energies are computed with a single call to
+	nucmass::mass_excess_list() or nucmass::binding_energy_list().
+	Otherwise, the nuclei are divided among the threads. In
+	either case, the contributions from each nucleus are summed
+	in the order given in \ref dist.
+    */
+    virtual void eval_para(std::vector<nucmass *> &nthr, double &res);
+
     /** \brief The default minimizer
 
 	The value of def_mmin::ntrial is automatically multiplied by
@@ -161,6 +192,27 @@ namespace o2scl {
 	This pointer is set by fit() and eval().
      */
     nucmass_fit_base *nmf;
+
+    /** \brief The per-thread copies of the nuclear mass formula
+
+	These pointers are set by fit_para() and cleared by fit().
+     */
+    std::vector<nucmass_fit_base *> nmf_thr;
+
+    /// The per-thread copies as \ref nucmass pointers for eval_para()
+    std::vector<nucmass *> nm_thr;
+
+    /// \name Workspace for eval_para()
+    //@{
+    /// Proton numbers of the selected nuclei
+    std::vector<int> sel_Z;
+    /// Neutron numbers of the selected nuclei
+    std::vector<int> sel_N;
+    /// Experimental values for the selected nuclei
+    std::vector<double> sel_exp;
+    /// Theoretical values for the selected nuclei
+    std::vector<double> sel_th;
+    //@}
     
 #endif
 
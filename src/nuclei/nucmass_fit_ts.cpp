@@ -98,6 +98,37 @@ int main(void) {
   cout << res << endl;
   t.test_rel(res,0.894578,1.0e-4,"Moller fit 3");
 
+  // Compare the parallel and serial evaluations with several
+  // copies of the semi-empirical formula
+  {
+    nucmass_semi_empirical sem2[4];
+    std::vector<nucmass *> nthr;
+    std::vector<nucmass_fit_base *> nfthr;
+    for(size_t i=0;i<4;i++) {
+      sem2[i]=sem;
+      nthr.push_back(&sem2[i]);
+      nfthr.push_back(&sem2[i]);
+    }
+    
+    double res2;
+    mf.fit_method=nucmass_fit::rms_mass_excess;
+    mf.eval(sem,res);
+    mf.eval_para(nthr,res2);
+    t.test_rel(res,res2,1.0e-12,"eval_para rms_mass_excess");
+    
+    mf.fit_method=nucmass_fit::chi_squared_be;
+    mf.eval(sem,res);
+    mf.eval_para(nthr,res2);
+    t.test_rel(res,res2,1.0e-12,"eval_para chi_squared_be");
+
+    mf.fit_method=nucmass_fit::rms_mass_excess;
+    mf.fit_para(nfthr,res2);
+    mf.eval(sem2[0],res);
+    t.test_rel(res,res2,1.0e-12,"fit_para result");
+    t.test_gen(res2<4.0,"Successful parallel fit.");
+    t.test_rel(sem2[0].B,sem2[3].B,1.0e-12,"fit_para copies");
+  }
+
 #endif
   
   t.report();
@@ -411,9 +411,8 @@ namespace o2scl {
     
     /** \brief Get the entry for the specified proton and neutron number
 	
-	This method searches the table using a cached binary search
-	algorithm. It is assumed that the table is sorted first by
-	proton number and then by neutron number.
+	This method uses the index constructed when the table
+	was loaded, so it requires only constant time.
     */
     nucmass_mnmsk::entry get_ZN(int l_Z, int l_N);
     
@@ -454,9 +453,6 @@ namespace o2scl {
     /// The array containing the mass data of length ame::n
     nucmass_mnmsk::entry *mass;
     
-    /// The last table index for caching
-    int last;
-    
 #endif
     
   };
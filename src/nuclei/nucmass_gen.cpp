@@ -71,30 +71,24 @@ int nucmass_gen::load_be(std::string fname, std::string be_col,
   }
   mex_col_ix=data.lookup_column("mex");
   
-  last=n/2;
+  std::vector<int> vZ(n), vN(n);
+  for(size_t i=0;i<n;i++) {
+    vZ[i]=((int)(data.get("Z",i)+1.0e-6));
+    vN[i]=((int)(data.get("N",i)+1.0e-6));
+  }
+  index_build(n,vZ,vN);
 
   return 0;
 }
 
 bool nucmass_gen::is_included(int l_Z, int l_N) {
-
-  for(size_t i=0;i<n;i++) {
-    if (fabs(data.get("Z",i)-l_Z)<1.0e-12 &&
-	fabs(data.get("N",i)-l_N)<1.0e-12) {
-      return true;
-    }
-  }
-
-  return false;
+  return (index_find(l_Z,l_N)>=0);
 }
 
 double nucmass_gen::mass_excess(int l_Z, int l_N) {
-  for(size_t i=0;i<n;i++) {
-    if (fabs(data.get("Z",i)-l_Z)<1.0e-12 &&
-	fabs(data.get("N",i)-l_N)<1.0e-12) {
-      return data.get(mex_col_ix,i);
-    }
-  }
+
+  int ix=index_find(l_Z,l_N);
+  if (ix>=0) return data.get(mex_col_ix,ix);
   
   O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
 	     " not found in nucmass_gen::mass_excess().").c_str(),
@@ -104,12 +98,9 @@ double nucmass_gen::mass_excess(int l_Z, int l_N) {
 }
 
 double nucmass_gen::get_string(int l_Z, int l_N, std::string column) {
-  for(size_t i=0;i<n;i++) {
-    if (fabs(data.get("Z",i)-l_Z)<1.0e-12 &&
-	fabs(data.get("N",i)-l_N)<1.0e-12) {
-      return data.get(column,i);
-    }
-  }
+
+  int ix=index_find(l_Z,l_N);
+  if (ix>=0) return data.get(column,ix);
   
   O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
 	     " not found in nucmass_gen::mass_excess().").c_str(),
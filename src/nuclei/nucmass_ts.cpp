@@ -245,6 +245,30 @@ int main(void) {
   
   t.test_gen(ame95rmd.get_nentries()==2931,"ame.n");
 
+  // Test the (Z,N) index against the table entries
+  
+  size_t n_ame=0, n_m95=0;
+  bool ix_ok=true;
+  for(int Z=0;Z<=130;Z++) {
+    for(int N=0;N<=250;N++) {
+      if (ame.is_included(Z,N)) {
+	nucmass_ame::entry ae=ame.get_ZN(Z,N);
+	if (ae.Z!=Z || ae.N!=N) ix_ok=false;
+	n_ame++;
+      }
+      if (m95.is_included(Z,N)) {
+	nucmass_mnmsk::entry me=m95.get_ZN(Z,N);
+	if (me.Z!=Z || me.N!=N) ix_ok=false;
+	n_m95++;
+      }
+    }
+  }
+  t.test_gen(ix_ok,"index entries");
+  t.test_gen(n_ame>0 && n_ame<=ame.get_nentries(),"index ame");
+  t.test_gen(n_m95>0 && n_m95<=m95.get_nentries(),"index m95");
+  t.test_gen(!ame.is_included(-1,10) && !ame.is_included(300,10),
+	     "index out of range");
+
   // Test nucmass_radius
   nucmass_radius nr;
   double rho0, N, N_err;
@@ -466,8 +466,8 @@ namespace o2scl {
     last_step=0.0;
 
     if (n!=msize) {
-      yout_int.resize(n);
-      dydx_int.resize(n);
+      o2scl::vector_resize(yout_int,n);
+      o2scl::vector_resize(dydx_int,n);
       msize=n;
     }
       
@@ -511,8 +511,8 @@ namespace o2scl {
     last_step=0.0;
 
     if (n!=msize) {
-      yout_int.resize(n);
-      dydx_int.resize(n);
+      o2scl::vector_resize(yout_int,n);
+      o2scl::vector_resize(dydx_int,n);
       msize=n;
     }
 
@@ -578,6 +578,32 @@ namespace o2scl {
             
   };
 
+  /** \brief Adaptive ODE stepper for small fixed-size systems
+
+      This is \ref astep_gsl with <tt>std::array<double,N></tt>
+      vectors which uses \ref ode_rkck_gsl_fixed as the default
+      stepper, so that no memory is allocated during the integration
+      and the derivative function can be inlined. It can be given to
+      \ref ode_iv_solve::set_astep() for an \ref ode_iv_solve object
+      with the same vector and function types.
+  */
+  template<size_t N, class func_t=std::function<int
+    (double,size_t,const std::array<double,N> &,std::array<double,N> &)> >
+    class astep_gsl_fixed : 
+    public astep_gsl<std::array<double,N>,std::array<double,N>,
+    std::array<double,N>,func_t> {
+    
+  public:
+
+  astep_gsl_fixed() {
+    this->set_step(fixed_step);
+  }
+  
+  /// The default fixed-size stepper
+  ode_rkck_gsl_fixed<N,func_t> fixed_step;
+
+  };
+
 #ifndef DOXYGEN_NO_O2NS
 }
 #endif
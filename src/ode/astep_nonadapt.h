@@ -81,7 +81,7 @@ namespace o2scl {
       
     virtual ~astep_nonadapt() {
       if (msize>0) {
-	dydx_int.clear();
+	o2scl::vector_resize(dydx_int,0);
       }
     }
 
@@ -105,7 +105,7 @@ namespace o2scl {
 		      vec_yerr_t &yerr, func_t &derivs) {
 
       if (n!=msize) {
-	dydx_int.resize(n);
+	o2scl::vector_resize(dydx_int,n);
       }
       
       derivs(x,n,y,dydx_int);
@@ -45,6 +45,14 @@ namespace o2scl {
 			    boost::numeric::ublas::vector<double> &)> 
     ode_funct;
   
+  /** \brief Ordinary differential equation function for an ensemble
+      of trajectories in src/ode/ode_funct.h
+
+      See \ref ode_iv_ensemble for the meaning of the arguments.
+   */
+  typedef std::function<int(size_t,size_t,const double *,
+			    const double *,double *)> ode_funct_ensemble;
+  
   /** \brief One-dimensional function from strings
       \nothing
   */
@@ -28,6 +28,8 @@
 */
 
 #include <iostream>
+#include <vector>
+#include <cmath>
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/vector_proxy.hpp>
@@ -51,6 +53,19 @@ namespace o2scl {
   /** \brief ODE solver using a generic linear solver to solve 
       finite-difference equations
 
+      The Jacobian of the finite-difference equations is banded,
+      with at most <tt>nb_left+n_eq-1</tt> nonzero subdiagonals and
+      <tt>2*n_eq-1-nb_left</tt> nonzero superdiagonals. By default
+      (when \ref use_banded is true) the Jacobian is stored in
+      banded form and solved with an LU decomposition with partial
+      pivoting which preserves the band structure. This requires
+      \f$ {\cal O}(n_{\mathrm{grid}} n_{\mathrm{eq}}^3) \f$ time and
+      \f$ {\cal O}(n_{\mathrm{grid}} n_{\mathrm{eq}}^2) \f$ memory
+      for each iteration, rather than the \f$ {\cal O}
+      (n_{\mathrm{grid}}^3 n_{\mathrm{eq}}^3) \f$ time and \f$ {\cal
+      O} (n_{\mathrm{grid}}^2 n_{\mathrm{eq}}^2) \f$ memory required
+      for the generic linear solver.
+
       \future Set up convergence error if it goes beyond max iterations
       \future Create a GSL-like set() and iterate() interface
       \future Implement as a child of ode_bv_solve ?
@@ -80,6 +95,7 @@ namespace o2scl {
     solver=&def_solver;
     alpha=1.0;
     make_mats=false;
+    use_banded=true;
     fd=0;
     fl=0;
     fr=0;
@@ -105,9 +121,23 @@ namespace o2scl {
   /// Maximum number of iterations (default 30)
   size_t niter;
   
-  /// Set the linear solver
+  /** \brief If true, use the internal banded solver instead of
+      the generic linear solver (default true)
+
+      When this is true, the matrix \c mat given to \ref solve()
+      and \ref solve_derivs() is not used (unless \ref make_mats is
+      true) and can be empty.
+  */
+  bool use_banded;
+  
+  /** \brief Set the linear solver
+
+      This function also sets \ref use_banded to false, so that
+      the specified solver is used.
+  */
   int set_solver(o2scl_linalg::linear_solver<solver_vec_t,solver_mat_t> &ls) {
     solver=&ls;
+    use_banded=false;
     return 0;
   }
     
@@ -128,8 +158,9 @@ namespace o2scl {
       guess for the solution, a matrix of size <tt>[n_grid][n_eq]</tt>
       should be given in \c y. Upon success, \c y will contain an
       approximate solution of the differential equations. The matrix
-      \c mat is workspace of size <tt>[n_grid*n_eq][n_grid*n_eq]</tt>, and
-      the vectors \c rhs and \c y are workspace of size
+      \c mat is workspace of size <tt>[n_grid*n_eq][n_grid*n_eq]</tt>
+      (it is only used if \ref use_banded is false or \ref make_mats
+      is true), and the vectors \c rhs and \c y are workspace of size
       <tt>[n_grid*n_eq]</tt>.
   */
   int solve(size_t n_grid, size_t n_eq, size_t nb_left, vec_t &x, 
@@ -176,8 +207,9 @@ namespace o2scl {
       guess for the solution, a matrix of size <tt>[n_grid][n_eq]</tt>
       should be given in \c y. Upon success, \c y will contain an
       approximate solution of the differential equations. The matrix
-      \c mat is workspace of size <tt>[n_grid*n_eq][n_grid*n_eq]</tt>, and
-      the vectors \c rhs and \c y are workspace of size
+      \c mat is workspace of size <tt>[n_grid*n_eq][n_grid*n_eq]</tt>
+      (it is only used if \ref use_banded is false or \ref make_mats
+      is true), and the vectors \c rhs and \c y are workspace of size
       <tt>[n_grid*n_eq]</tt>.
   */
   template<class dfunc_t>
@@ -194,15 +226,30 @@ namespace o2scl {
 
     // Number of variables
     size_t nvars=n_grid*n_eq;
+
+    // Use the banded solver unless the full matrix was requested
+    band_step=(use_banded && !make_mats);
+    if (band_step) {
+      band_kl=nb_left+n_eq-1;
+      band_ku=2*n_eq-1-nb_left;
+      band_ld=2*band_kl+band_ku+1;
+      band_n=nvars;
+      band.resize(band_ld*nvars);
+      band_piv.resize(nvars);
+    }
     
     bool done=false;
     for(size_t it=0;done==false && it<niter;it++) {
       
       ix=0;
-      
-      for(size_t i=0;i<nvars;i++) {
-	for(size_t j=0;j<nvars;j++) {
-	  mat(i,j)=0.0;
+
+      if (band_step) {
+	for(size_t i=0;i<band.size();i++) band[i]=0.0;
+      } else {
+	for(size_t i=0;i<nvars;i++) {
+	  for(size_t j=0;j<nvars;j++) {
+	    mat(i,j)=0.0;
+	  }
 	}
       }
 
@@ -212,7 +259,7 @@ namespace o2scl {
 	matrix_row_t yk=o2scl::matrix_row<mat_t,matrix_row_t>(y,0);
 	rhs[ix]=-left(i,x[0],yk);
 	for(size_t j=0;j<n_eq;j++) {
-	  mat(ix,j)=d_left(i,j,x[0],yk);
+	  set_jac(mat,ix,j,d_left(i,j,x[0],yk));
 	}
 	ix++;
       }
@@ -233,12 +280,14 @@ namespace o2scl {
 	  
 	  size_t lhs=k*n_eq;
 	  for(size_t j=0;j<n_eq;j++) {
-	    mat(ix,lhs+j)=-d_derivs(i,j,tx,yk)*dx/2.0;
-	    mat(ix,lhs+j+n_eq)=-d_derivs(i,j,tx,ykp1)*dx/2.0;
+	    double m_k=-d_derivs(i,j,tx,yk)*dx/2.0;
+	    double m_kp1=-d_derivs(i,j,tx,ykp1)*dx/2.0;
 	    if (i==j) {
-	      mat(ix,lhs+j)=mat(ix,lhs+j)-1.0;
-	      mat(ix,lhs+j+n_eq)=mat(ix,lhs+j+n_eq)+1.0;
+	      m_k-=1.0;
+	      m_kp1+=1.0;
 	    }
+	    set_jac(mat,ix,lhs+j,m_k);
+	    set_jac(mat,ix,lhs+j+n_eq,m_kp1);
 	  }
 
 	  ix++;
@@ -256,7 +305,7 @@ namespace o2scl {
 	rhs[ix]=-right(i,x[n_grid-1],ylast);
 	
 	for(size_t j=0;j<n_eq;j++) {
-	  mat(ix,lhs+j)=d_right(i,j,x[n_grid-1],ylast);
+	  set_jac(mat,ix,lhs+j,d_right(i,j,x[n_grid-1],ylast));
 	}
 	  
 	ix++;
@@ -269,7 +318,15 @@ namespace o2scl {
 	std::cout << "Matrix: " << std::endl;
 	for(size_t i=0;i<nvars;i++) {
 	  for(size_t j=0;j<nvars;j++) {
-	    std::cout << mat(i,j) << " ";
+	    if (band_step) {
+	      if (i<=j+band_kl && j<=i+band_ku) {
+		std::cout << band_elem(i,j) << " ";
+	      } else {
+		std::cout << 0.0 << " ";
+	      }
+	    } else {
+	      std::cout << mat(i,j) << " ";
+	    }
 	  }
 	  std::cout << std::endl;
 	}
@@ -281,7 +338,11 @@ namespace o2scl {
 
       if (make_mats) return 0;
 
-      solver->solve(ix,mat,rhs,dy);
+      if (band_step) {
+	band_solve(rhs,dy);
+      } else {
+	solver->solve(ix,mat,rhs,dy);
+      }
 
       if (verbose>3) {
 	std::cout << "Corrections:" << std::endl;
@@ -344,6 +405,129 @@ namespace o2scl {
   /// Solver
   o2scl_linalg::linear_solver<solver_vec_t,solver_mat_t> *solver;
 
+  /// \name Storage for the banded solver
+  //@{
+  /// If true, the current solve is using the banded solver
+  bool band_step;
+  /// Number of subdiagonals
+  size_t band_kl;
+  /// Number of superdiagonals (not including fill-in)
+  size_t band_ku;
+  /// Number of stored diagonals for each column
+  size_t band_ld;
+  /// Size of the matrix
+  size_t band_n;
+  /** \brief The banded matrix, with element \f$ (i,j) \f$ stored
+      at <tt>band_kl+band_ku+i-j+j*band_ld</tt>
+  */
+  std::vector<double> band;
+  /// Pivots from the LU decomposition
+  std::vector<size_t> band_piv;
+  //@}
+
+  /// Return element \f$ (i,j) \f$ of the banded matrix
+  double &band_elem(size_t i, size_t j) {
+    return band[band_kl+band_ku+i-j+j*band_ld];
+  }
+  
+  /// Set element \f$ (i,j) \f$ of the Jacobian
+  void set_jac(solver_mat_t &mat, size_t i, size_t j, double val) {
+    if (band_step) {
+      band_elem(i,j)=val;
+    } else {
+      mat(i,j)=val;
+    }
+    return;
+  }
+
+  /** \brief Solve the banded system with right-hand side \c rhs
+      and store the result in \c dy
+
+      This performs an LU decomposition with partial pivoting
+      in place (following LAPACK's \c dgbtf2), requiring
+      \f$ {\cal O}(n k_l (k_l+k_u)) \f$ operations. The vector
+      \c rhs is unchanged.
+  */
+  void band_solve(const solver_vec_t &rhs, solver_vec_t &dy) {
+
+    size_t n=band_n;
+    
+    // The last column which has been modified by the 
+    // row interchanges
+    size_t ju=0;
+    
+    for(size_t c=0;c<n;c++) {
+
+      size_t r_max=c+band_kl;
+      if (r_max>n-1) r_max=n-1;
+
+      // Find the pivot
+      size_t p=c;
+      double amax=fabs(band_elem(c,c));
+      for(size_t r=c+1;r<=r_max;r++) {
+	if (fabs(band_elem(r,c))>amax) {
+	  amax=fabs(band_elem(r,c));
+	  p=r;
+	}
+      }
+      band_piv[c]=p;
+      if (amax==0.0) {
+	O2SCL_ERR2("Singular matrix in ",
+		   "ode_it_solve::band_solve().",o2scl::exc_esing);
+      }
+
+      size_t j_max=p+band_ku;
+      if (j_max>n-1) j_max=n-1;
+      if (j_max>ju) ju=j_max;
+      
+      // Swap rows
+      if (p!=c) {
+	for(size_t j=c;j<=ju;j++) {
+	  std::swap(band_elem(c,j),band_elem(p,j));
+	}
+      }
+
+      // Eliminate below the diagonal
+      double diag=band_elem(c,c);
+      for(size_t r=c+1;r<=r_max;r++) {
+	double l=band_elem(r,c)/diag;
+	band_elem(r,c)=l;
+	if (l!=0.0) {
+	  for(size_t j=c+1;j<=ju;j++) {
+	    band_elem(r,j)-=l*band_elem(c,j);
+	  }
+	}
+      }
+    }
+
+    // Forward substitution
+    for(size_t i=0;i<n;i++) dy[i]=rhs[i];
+    for(size_t c=0;c<n;c++) {
+      size_t p=band_piv[c];
+      if (p!=c) std::swap(dy[c],dy[p]);
+      size_t r_max=c+band_kl;
+      if (r_max>n-1) r_max=n-1;
+      for(size_t r=c+1;r<=r_max;r++) {
+	dy[r]-=band_elem(r,c)*dy[c];
+      }
+    }
+
+    // Back substitution with the upper triangular factor, which
+    // has band_kl+band_ku superdiagonals
+    for(size_t ii=n;ii>0;ii--) {
+      size_t i=ii-1;
+      size_t j_max=i+band_kl+band_ku;
+      if (j_max>n-1) j_max=n-1;
+      double sum=dy[i];
+      for(size_t j=i+1;j<=j_max;j++) {
+	sum-=band_elem(i,j)*dy[j];
+      }
+      dy[i]=sum/band_elem(i,i);
+    }
+    
+    return;
+  }
+
   /** \brief Compute the derivatives of the LHS boundary conditions
 
       This function computes \f$ \partial f_{left,\mathrm{ieq}} / \partial
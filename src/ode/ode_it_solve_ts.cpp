@@ -464,6 +464,64 @@ int main(void) {
   
   }
 
+  // System 1 with the banded solver and the dense solver
+  {
+    ubvector x(11);
+    ubmatrix y(11,2), y2(11,2);
+    for(int i=0;i<11;i++) {
+      x[i]=((double)i)/10.0;
+      y(i,0)=2.0*x[i];
+      y(i,1)=1.0+x[i]/2;
+      y2(i,0)=y(i,0);
+      y2(i,1)=y(i,1);
+    }
+  
+    ubmatrix A(22,22), A_empty;
+    ubvector rhs(22), dy(22);
+    fc1 f1;
+
+    ode_it_funct f_derivs=std::bind
+      (std::mem_fn<double(size_t,double,ubmatrix_row &)>
+       (&fc1::derivs),&f1,std::placeholders::_1,std::placeholders::_2,
+       std::placeholders::_3);       
+    ode_it_funct f_left=std::bind
+      (std::mem_fn<double(size_t,double,ubmatrix_row &)>
+       (&fc1::left),&f1,std::placeholders::_1,std::placeholders::_2,
+       std::placeholders::_3);       
+    ode_it_funct f_right=std::bind
+      (std::mem_fn<double(size_t,double,ubmatrix_row &)>
+       (&fc1::right),&f1,std::placeholders::_1,std::placeholders::_2,
+       std::placeholders::_3);       
+
+    ode_it_solve<> oit;
+    oit.solve(11,2,1,x,y,f_derivs,f_left,f_right,A_empty,rhs,dy);
+    oit.use_banded=false;
+    oit.solve(11,2,1,x,y2,f_derivs,f_left,f_right,A,rhs,dy);
+    for(int kk=0;kk<11;kk++) {
+      t.test_rel(y(kk,0),y2(kk,0),1.0e-8,"banded vs. dense 1");
+      t.test_rel(y(kk,1),y2(kk,1),1.0e-8,"banded vs. dense 2");
+    }
+
+    // A fine grid which would be impractical with the dense solver
+    size_t n_fine=2001;
+    ubvector xf(n_fine);
+    ubmatrix yf(n_fine,2);
+    for(size_t i=0;i<n_fine;i++) {
+      xf[i]=((double)i)/((double)(n_fine-1));
+      yf(i,0)=2.0*xf[i];
+      yf(i,1)=1.0+xf[i]/2;
+    }
+    ubvector rhsf(2*n_fine), dyf(2*n_fine);
+    oit.use_banded=true;
+    oit.solve(n_fine,2,1,xf,yf,f_derivs,f_left,f_right,A_empty,rhsf,dyf);
+    t.test_rel(yf(n_fine-1,0),2.0,1.0e-10,"banded fine grid 1");
+    t.test_rel(yf(0,1),1.0,1.0e-10,"banded fine grid 2");
+    for(size_t kk=200;kk<n_fine;kk+=200) {
+      t.test_rel(yf(kk,0),y(kk/200,0),5.0e-2,"banded fine grid 3");
+      t.test_rel(yf(kk,1),y(kk/200,1),5.0e-2,"banded fine grid 4");
+    }
+  }
+
 #ifdef O2SCL_NEVER_DEFINED
 
 #ifdef O2SCL_ARMA
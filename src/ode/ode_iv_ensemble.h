@@ -0,0 +1,520 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2006-2019, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_ODE_IV_ENSEMBLE_H
+#define O2SCL_ODE_IV_ENSEMBLE_H
+
+/** \file ode_iv_ensemble.h
+    \brief File defining \ref o2scl::ode_iv_ensemble
+*/
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <boost/numeric/ublas/vector.hpp>
+
+#include <gsl/gsl_math.h>
+
+#include <o2scl/err_hnd.h>
+#include <o2scl/string_conv.h>
+#include <o2scl/ode_funct.h>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
+#ifndef DOXYGEN_NO_O2NS
+namespace o2scl {
+#endif
+
+  /** \brief Solve an initial-value ODE problem for an ensemble
+      of initial conditions
+
+      This class integrates the same system of \c n ODEs from \c x0
+      to \c x1 for \c nt independent sets of initial conditions
+      (trajectories). Each trajectory has its own adaptive stepsize,
+      and takes the same steps as \ref ode_iv_solve::solve_final_value()
+      would with the default stepper (\ref astep_gsl with \ref
+      ode_rkck_gsl and the standard control from \ref
+      ode_control_gsl). In each round, all of the trajectories
+      which have not yet reached \c x1 attempt a step together, so
+      the derivative function is called once per Runge-Kutta stage
+      for all of them.
+
+      The stepper is fixed. Since \ref ode_rkck_gsl and \ref
+      ode_control_gsl operate on one trajectory at a time, the
+      Cash-Karp coefficients and the standard stepsize adjustment of
+      \ref ode_control_gsl::hadjust() are reimplemented here for a
+      batch of trajectories, and must be kept consistent with those
+      classes. A different stepper cannot be specified, and only the
+      tolerances \ref eps_abs, \ref eps_rel, \ref a_y and \ref
+      a_dydt can be changed.
+
+      All vectors use a structure-of-arrays layout, i.e. element \c
+      i of trajectory \c k is stored at index <tt>i*nt+k</tt>. The
+      derivative function has the form
+      \code
+      int derivs(size_t nt, size_t n, const double *x,
+      const double *y, double *dydx);
+      \endcode
+      where \c x is an array of size \c nt giving the value of the
+      independent variable for each trajectory and \c y and \c dydx
+      are arrays of size <tt>n*nt</tt> with the same layout. The
+      value of \c nt given to the derivative function is the number
+      of trajectories in the current batch, which is smaller than
+      the full ensemble once some trajectories have finished. Since
+      the values for different trajectories are contiguous, loops
+      over the trajectories in the derivative function can be
+      vectorized by the compiler.
+
+      If \ref n_threads is larger than one and OpenMP is enabled,
+      the ensemble is divided into \ref n_threads contiguous blocks
+      which are integrated in parallel, so the derivative function
+      must then be safe to call from several threads at once.
+
+      If a trajectory requires more than \ref ntrial steps or its
+      stepsize can no longer be decreased, it is stopped and the
+      corresponding entry in \ref status is set to \ref
+      o2scl::exc_emaxiter or \ref o2scl::exc_efailed. The other
+      trajectories are unaffected. After all trajectories are
+      finished, the error handler is called if \ref err_nonconv is
+      true, and otherwise the first non-zero status is returned.
+
+      \future Allow a different final point for each trajectory.
+  */
+  template<class func_t=ode_funct_ensemble,
+	   class vec_t=boost::numeric::ublas::vector<double> >
+  class ode_iv_ensemble {
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// \name Storage for the coefficients
+    //@{
+    double ah[5], b3[2], b4[3], b5[4], b6[5], ec[7];
+    double b21, c1, c3, c4, c6;
+    //@}
+
+    /// The current value of the independent variable for each trajectory
+    std::vector<double> x_traj;
+
+    /// The current stepsize for each trajectory
+    std::vector<double> h_traj;
+
+    /// The derivatives for the full ensemble
+    std::vector<double> dydx_all;
+
+    /** \brief Integrate trajectories \c k0 to <tt>k1-1</tt> of \c
+	yend from \c x0 to \c x1
+    */
+    int solve_block(double x0, double x1, size_t n, size_t nt,
+		    size_t k0, size_t k1, vec_t &yend, func_t &derivs) {
+
+      const double S=0.9;
+      const double ord=5.0;
+
+      size_t nb=k1-k0;
+
+      // Indices of the trajectories in the current batch and
+      // storage for the batch
+      std::vector<size_t> act(nb);
+      std::vector<bool> fin(nb,false), last(nb);
+      std::vector<double> bx(nb), bh(nb), bxs(nb);
+      std::vector<double> y(n*nb), dydx(n*nb), ytmp(n*nb), yout(n*nb);
+      std::vector<double> yerr(n*nb), dydx_out(n*nb);
+      std::vector<double> k2(n*nb), k3(n*nb), k4(n*nb), k5(n*nb);
+      std::vector<double> k6(n*nb);
+
+      // Compute the initial derivatives
+      for(size_t j=0;j<nb;j++) {
+	bx[j]=x0;
+	for(size_t i=0;i<n;i++) {
+	  y[i*nb+j]=yend[i*nt+k0+j];
+	}
+      }
+      int ret=derivs(nb,n,&bx[0],&y[0],&dydx[0]);
+      if (ret!=0) return ret;
+      for(size_t i=0;i<n;i++) {
+	for(size_t j=0;j<nb;j++) {
+	  dydx_all[i*nt+k0+j]=dydx[i*nb+j];
+	}
+      }
+
+      while (true) {
+
+	// Collect the trajectories which are not finished
+	size_t na=0;
+	for(size_t j=0;j<nb;j++) {
+	  if (fin[j]==false) {
+	    act[na]=k0+j;
+	    na++;
+	  }
+	}
+	if (na==0) break;
+
+	// Set up the batch, taking care not to go past x1
+	for(size_t j=0;j<na;j++) {
+	  size_t k=act[j];
+	  double dt=x1-x_traj[k];
+	  bx[j]=x_traj[k];
+	  bh[j]=h_traj[k];
+	  if ((dt>=0.0 && bh[j]>dt) || (dt<0.0 && bh[j]<dt)) {
+	    bh[j]=dt;
+	    last[j]=true;
+	  } else {
+	    last[j]=false;
+	  }
+	}
+	for(size_t i=0;i<n;i++) {
+	  for(size_t j=0;j<na;j++) {
+	    y[i*na+j]=yend[i*nt+act[j]];
+	    dydx[i*na+j]=dydx_all[i*nt+act[j]];
+	  }
+	}
+
+	// The Cash-Karp step, in the same order as ode_rkck_gsl
+
+	for(size_t i=0;i<n;i++) {
+	  for(size_t j=0;j<na;j++) {
+	    size_t ij=i*na+j;
+	    ytmp[ij]=y[ij]+b21*bh[j]*dydx[ij];
+	  }
+	}
+	for(size_t j=0;j<na;j++) bxs[j]=bx[j]+ah[0]*bh[j];
+	ret=derivs(na,n,&bxs[0],&ytmp[0],&k2[0]);
+	if (ret!=0) return ret;
+
+	for(size_t i=0;i<n;i++) {
+	  for(size_t j=0;j<na;j++) {
+	    size_t ij=i*na+j;
+	    ytmp[ij]=y[ij]+bh[j]*(b3[0]*dydx[ij]+b3[1]*k2[ij]);
+	  }
+	}
+	for(size_t j=0;j<na;j++) bxs[j]=bx[j]+ah[1]*bh[j];
+	ret=derivs(na,n,&bxs[0],&ytmp[0],&k3[0]);
+	if (ret!=0) return ret;
+
+	for(size_t i=0;i<n;i++) {
+	  for(size_t j=0;j<na;j++) {
+	    size_t ij=i*na+j;
+	    ytmp[ij]=y[ij]+bh[j]*(b4[0]*dydx[ij]+b4[1]*k2[ij]+
+				  b4[2]*k3[ij]);
+	  }
+	}
+	for(size_t j=0;j<na;j++) bxs[j]=bx[j]+ah[2]*bh[j];
+	ret=derivs(na,n,&bxs[0],&ytmp[0],&k4[0]);
+	if (ret!=0) return ret;
+
+	for(size_t i=0;i<n;i++) {
+	  for(size_t j=0;j<na;j++) {
+	    size_t ij=i*na+j;
+	    ytmp[ij]=y[ij]+bh[j]*(b5[0]*dydx[ij]+b5[1]*k2[ij]+
+				  b5[2]*k3[ij]+b5[3]*k4[ij]);
+	  }
+	}
+	for(size_t j=0;j<na;j++) bxs[j]=bx[j]+ah[3]*bh[j];
+	ret=derivs(na,n,&bxs[0],&ytmp[0],&k5[0]);
+	if (ret!=0) return ret;
+
+	for(size_t i=0;i<n;i++) {
+	  for(size_t j=0;j<na;j++) {
+	    size_t ij=i*na+j;
+	    ytmp[ij]=y[ij]+bh[j]*(b6[0]*dydx[ij]+b6[1]*k2[ij]+
+				  b6[2]*k3[ij]+b6[3]*k4[ij]+
+				  b6[4]*k5[ij]);
+	  }
+	}
+	for(size_t j=0;j<na;j++) bxs[j]=bx[j]+ah[4]*bh[j];
+	ret=derivs(na,n,&bxs[0],&ytmp[0],&k6[0]);
+	if (ret!=0) return ret;
+
+	for(size_t i=0;i<n;i++) {
+	  for(size_t j=0;j<na;j++) {
+	    size_t ij=i*na+j;
+	    yout[ij]=y[ij]+bh[j]*(c1*dydx[ij]+c3*k3[ij]+c4*k4[ij]+
+				  c6*k6[ij]);
+	    yerr[ij]=bh[j]*(ec[1]*dydx[ij]+ec[3]*k3[ij]+ec[4]*k4[ij]+
+			    ec[5]*k5[ij]+ec[6]*k6[ij]);
+	  }
+	}
+	for(size_t j=0;j<na;j++) bxs[j]=bx[j]+bh[j];
+	ret=derivs(na,n,&bxs[0],&yout[0],&dydx_out[0]);
+	if (ret!=0) return ret;
+
+	// Adjust the stepsize of each trajectory as in
+	// ode_control_gsl::hadjust() and accept or reject the step
+	for(size_t j=0;j<na;j++) {
+
+	  size_t k=act[j];
+
+	  double rmax=DBL_MIN;
+	  for(size_t i=0;i<n;i++) {
+	    size_t ij=i*na+j;
+	    double D0=eps_rel*(a_y*fabs(yout[ij])+
+			       a_dydt*fabs(bh[j]*dydx_out[ij]))+eps_abs;
+	    double r=fabs(yerr[ij])/fabs(D0);
+	    rmax=GSL_MAX_DBL(r,rmax);
+	  }
+
+	  double x_new=(last[j] ? x1 : bx[j]+bh[j]);
+
+	  if (rmax>1.1) {
+
+	    // Decrease the stepsize and try again
+	    double r=S/pow(rmax,1.0/ord);
+	    if (r<0.2) r=0.2;
+	    h_traj[k]=r*bh[j];
+
+	    // Give up if the stepsize cannot be decreased further
+	    if (fabs(h_traj[k])>=fabs(bh[j]) || x_new+h_traj[k]==x_new) {
+	      status[k]=exc_efailed;
+	      fin[k-k0]=true;
+	    }
+
+	  } else {
+
+	    // Accept the step
+	    x_traj[k]=x_new;
+	    for(size_t i=0;i<n;i++) {
+	      size_t ij=i*na+j;
+	      yend[i*nt+k]=yout[ij];
+	      dydx_all[i*nt+k]=dydx_out[ij];
+	    }
+	    nsteps[k]++;
+
+	    if (last[j]) {
+	      fin[k-k0]=true;
+	    } else {
+	      if (rmax<0.5) {
+		double r=S/pow(rmax,1.0/(ord+1.0));
+		if (r>5.0) r=5.0;
+		if (r<1.0) r=1.0;
+		h_traj[k]=r*bh[j];
+	      } else {
+		h_traj[k]=bh[j];
+	      }
+	      if (nsteps[k]>ntrial) {
+		status[k]=exc_emaxiter;
+		fin[k-k0]=true;
+	      }
+	    }
+
+	  }
+	}
+
+	// End of loop 'while (true)'
+      }
+
+      return 0;
+    }
+
+#endif
+
+  public:
+
+    ode_iv_ensemble() {
+
+      ah[0]=1.0/5.0;
+      ah[1]=3.0/10.0;
+      ah[2]=3.0/5.0;
+      ah[3]=1.0;
+      ah[4]=7.0/8.0;
+
+      b3[0]=3.0/40.0;
+      b3[1]=9.0/40.0;
+
+      b4[0]=3.0/10.0;
+      b4[1]=-9.0/10.0;
+      b4[2]=12.0/10.0;
+
+      b5[0]=-11.0/54.0;
+      b5[1]=5.0/2.0;
+      b5[2]=-70.0/27.0;
+      b5[3]=35.0/27.0;
+
+      b6[0]=1631.0/55296.0;
+      b6[1]=175.0/512.0;
+      b6[2]=575.0/13824.0;
+      b6[3]=44275.0/110592.0;
+      b6[4]=253.0/4096.0;
+
+      ec[0]=0.0;
+      ec[1]=37.0/378.0-2825.0/27648.0;
+      ec[2]=0.0;
+      ec[3]=250.0/621.0-18575.0/48384.0;
+      ec[4]=125.0/594.0-13525.0/55296.0;
+      ec[5]=-277.0/14336.0;
+      ec[6]=512.0/1771.0-1.0/4.0;
+
+      b21=1.0/5.0;
+
+      c1=37.0/378.0;
+      c3=250.0/621.0;
+      c4=125.0/594.0;
+      c6=512.0/1771.0;
+
+      eps_abs=1.0e-6;
+      eps_rel=0.0;
+      a_y=1.0;
+      a_dydt=0.0;
+      ntrial=1000;
+      n_threads=1;
+      err_nonconv=true;
+    }
+
+    virtual ~ode_iv_ensemble() {
+    }
+
+    /// \name Step size control (see \ref ode_control_gsl)
+    //@{
+    /// Absolute precision (default \f$ 10^{-6} \f$)
+    double eps_abs;
+    /// Relative precision (default 0)
+    double eps_rel;
+    /// Function scaling factor (default 1)
+    double a_y;
+    /// Derivative scaling factor (default 0)
+    double a_dydt;
+    //@}
+
+    /// Maximum number of steps for each trajectory (default 1000)
+    size_t ntrial;
+
+    /// Number of OpenMP threads (default 1)
+    size_t n_threads;
+
+    /** \brief If true, call the error handler if any trajectory
+	does not converge (default true)
+    */
+    bool err_nonconv;
+
+    /// The number of steps taken by each trajectory
+    std::vector<size_t> nsteps;
+
+    /// The status of each trajectory (zero for success)
+    std::vector<int> status;
+
+    /** \brief Solve the initial-value problem for all trajectories
+
+	Given the initial values in \c ystart, this function
+	integrates the \c n ODEs specified in \c derivs for \c nt
+	trajectories from \c x0 to \c x1 with an initial stepsize of
+	\c h and places the final values in \c yend. The vectors \c
+	ystart and \c yend must have size <tt>n*nt</tt> and use the
+	layout described in the class documentation. They may refer
+	to the same object.
+    */
+    int solve_final_value(double x0, double x1, double h, size_t n,
+			  size_t nt, const vec_t &ystart, vec_t &yend,
+			  func_t &derivs) {
+
+      if ((x1>x0 && h<=0.0) || (x0>x1 && h>=0.0)) {
+	std::string str="Interval direction (x1-x0="+o2scl::dtos(x1-x0)+
+	  ") does not match step direction (h="+o2scl::dtos(h)+
+	  " in ode_iv_ensemble::solve_final_value().";
+	O2SCL_ERR(str.c_str(),exc_einval);
+      }
+      if (x0==x1) {
+	O2SCL_ERR2("Starting and final endpoints identical in ",
+		   "ode_iv_ensemble::solve_final_value().",exc_einval);
+      }
+      if (nt==0) return 0;
+
+      if (&ystart!=&yend) {
+	for(size_t i=0;i<n*nt;i++) yend[i]=ystart[i];
+      }
+
+      x_traj.resize(nt);
+      h_traj.resize(nt);
+      dydx_all.resize(n*nt);
+      nsteps.resize(nt);
+      status.resize(nt);
+      for(size_t k=0;k<nt;k++) {
+	x_traj[k]=x0;
+	h_traj[k]=h;
+	nsteps[k]=0;
+	status[k]=0;
+      }
+
+      size_t n_chunk=n_threads;
+      if (n_chunk<1) n_chunk=1;
+      if (n_chunk>nt) n_chunk=nt;
+
+      std::vector<int> rets(n_chunk,0);
+
+#ifdef O2SCL_OPENMP
+
+      o2scl::err_para_store eps(n_chunk);
+
+#pragma omp parallel for default(shared) num_threads(n_chunk) schedule(static)
+      for(size_t ic=0;ic<n_chunk;ic++) {
+	size_t k0=ic*nt/n_chunk;
+	size_t k1=(ic+1)*nt/n_chunk;
+	eps.run(ic,[&]() {
+	    rets[ic]=solve_block(x0,x1,n,nt,k0,k1,yend,derivs);
+	  });
+      }
+      // End of parallel region
+
+      eps.rethrow();
+
+#else
+
+      for(size_t ic=0;ic<n_chunk;ic++) {
+	size_t k0=ic*nt/n_chunk;
+	size_t k1=(ic+1)*nt/n_chunk;
+	rets[ic]=solve_block(x0,x1,n,nt,k0,k1,yend,derivs);
+      }
+
+#endif
+
+      for(size_t ic=0;ic<n_chunk;ic++) {
+	if (rets[ic]!=0) {
+	  O2SCL_ERR2("Derivative function failed in ",
+		     "ode_iv_ensemble::solve_final_value().",rets[ic]);
+	}
+      }
+
+      for(size_t k=0;k<nt;k++) {
+	if (status[k]!=0) {
+	  std::string str="Trajectory "+szttos(k)+" failed at x="+
+	    o2scl::dtos(x_traj[k])+" in "+
+	    "ode_iv_ensemble::solve_final_value().";
+	  O2SCL_CONV_RET(str.c_str(),status[k],err_nonconv);
+	}
+      }
+
+      return 0;
+    }
+
+    /// Return the type, \c "ode_iv_ensemble".
+    virtual const char *type() { return "ode_iv_ensemble"; }
+
+  };
+
+#ifndef DOXYGEN_NO_O2NS
+}
+#endif
+
+#endif
@@ -0,0 +1,120 @@
+/*
+  -------------------------------------------------------------------
+  
+  Copyright (C) 2006-2019, Andrew W. Steiner
+  
+  This file is part of O2scl.
+  
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+  
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <o2scl/ode_iv_ensemble.h>
+#include <o2scl/ode_iv_solve.h>
+#include <o2scl/test_mgr.h>
+#include <o2scl/exception.h>
+
+using namespace std;
+using namespace o2scl;
+
+typedef boost::numeric::ublas::vector<double> ubvector;
+
+// A nonlinear oscillator, so that the stepsizes depend on the
+// initial conditions
+int derivs(double x, size_t nv, const ubvector &y, ubvector &dydx) {
+  dydx[0]=y[1];
+  dydx[1]=-y[0]*(1.0+y[0]*y[0]);
+  return 0;
+}
+
+int derivs_ens(size_t nt, size_t nv, const double *x, const double *y,
+	       double *dydx) {
+  for(size_t k=0;k<nt;k++) {
+    dydx[k]=y[nt+k];
+    dydx[nt+k]=-y[k]*(1.0+y[k]*y[k]);
+  }
+  return 0;
+}
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+
+  test_mgr t;
+  t.set_output_level(1);
+
+  size_t nt=37;
+  ubvector ystart(2*nt), yend(2*nt), yend2(2*nt);
+  for(size_t k=0;k<nt;k++) {
+    ystart[k]=0.1+0.1*((double)k);
+    ystart[nt+k]=0.0;
+  }
+
+  ode_funct_ensemble fe=derivs_ens;
+  ode_iv_ensemble<> ens;
+  ens.solve_final_value(0.0,5.0,0.1,2,nt,ystart,yend,fe);
+
+  // Compare with ode_iv_solve for each trajectory
+  ode_iv_solve<> ivs;
+  ode_funct od=derivs;
+  ubvector y(2), y1(2);
+  for(size_t k=0;k<nt;k++) {
+    y[0]=ystart[k];
+    y[1]=ystart[nt+k];
+    ivs.solve_final_value(0.0,5.0,0.1,2,y,y1,od);
+    t.test_gen(ens.nsteps[k]==ivs.nsteps,"nsteps");
+    t.test_rel(yend[k],y1[0],1.0e-14,"y0");
+    t.test_rel(yend[nt+k],y1[1],1.0e-14,"y1");
+  }
+  cout << ens.nsteps[0] << " " << ens.nsteps[nt-1] << endl;
+
+  // Integrate backwards to recover the initial conditions
+  ens.solve_final_value(5.0,0.0,-0.1,2,nt,yend,yend2,fe);
+  for(size_t k=0;k<nt;k++) {
+    t.test_rel(yend2[k],ystart[k],1.0e-4,"backwards");
+  }
+
+  // Multiple threads give the same results
+  ens.n_threads=4;
+  ens.solve_final_value(0.0,5.0,0.1,2,nt,ystart,yend2,fe);
+  for(size_t k=0;k<2*nt;k++) {
+    t.test_rel(yend2[k],yend[k],1.0e-14,"threads");
+  }
+
+  // An error in the derivative function is rethrown with its
+  // original type
+  ode_funct_ensemble fe_err=[](size_t nt2, size_t nv, const double *x,
+			       const double *y, double *dydx) -> int {
+    O2SCL_ERR("Test error in derivatives.",exc_einval);
+    return 0;
+  };
+  bool caught=false;
+  try {
+    ens.solve_final_value(0.0,5.0,0.1,2,nt,ystart,yend2,fe_err);
+  } catch (exc_invalid_argument &e) {
+    caught=true;
+  }
+  t.test_gen(caught,"threads error type");
+  ens.n_threads=1;
+
+  // Too few steps
+  ens.err_nonconv=false;
+  ens.ntrial=5;
+  int ret=ens.solve_final_value(0.0,5.0,0.1,2,nt,ystart,yend2,fe);
+  t.test_gen(ret==exc_emaxiter,"nonconv");
+  t.test_gen(ens.status[0]==exc_emaxiter,"nonconv status");
+
+  t.report();
+  return 0;
+}
@@ -28,6 +28,7 @@
 */
 
 #include <string>
+#include <vector>
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
@@ -55,6 +56,13 @@ namespace o2scl {
       guaranteed) as solve_final_value() and additionally records some
       or all of the results from the adaptive steps which were taken.
 
+      The function solve_dense() also performs the same integration
+      as solve_final_value(), but stores the solution at the end of
+      every step so that it can be evaluated at arbitrary points
+      afterwards with dense_eval(), without constraining the step
+      sizes. The function solve_grid() uses this to compute the
+      solution on a user-specified grid.
+
       All of these functions automatically evaluate the derivatives
       from the specified function at the initial point and
       user-specified initial derivatives are ignored. The total
@@ -121,6 +129,30 @@ namespace o2scl {
     /// The adaptive stepper
     astep_base<vec_t,vec_t,vec_t,func_t> *astp;
     
+    /// \name Dense output storage
+    //@{
+    /// If true, solve_final_value() records each step
+    bool dense_rec;
+    /// The number of functions in the stored solution
+    size_t dense_nv;
+    /// The values of the independent variable at each step
+    std::vector<double> dense_x;
+    /// The function values, derivatives, and errors at each step
+    std::vector<double> dense_y, dense_dydx, dense_yerr;
+    //@}
+
+    /// Record the solution at the end of a step
+    void dense_push(double x, size_t n, const vec_t &y, const vec_t &dydx,
+		    const vec_t &yerr) {
+      dense_x.push_back(x);
+      for(size_t i=0;i<n;i++) {
+	dense_y.push_back(y[i]);
+	dense_dydx.push_back(dydx[i]);
+	dense_yerr.push_back(yerr[i]);
+      }
+      return;
+    }
+
     /// Print out iteration information
     virtual int print_iter(double x, size_t nv, vec_t &y) {
       std::cout << type() << " x: " << x << " y: ";
@@ -136,10 +168,10 @@ namespace o2scl {
     /// Free allocated memory
     void free() {
       if (mem_size>0) {
-	vtemp.clear();
-	vtemp2.clear();
-	vtemp3.clear();
-	vtemp4.clear();
+	o2scl::vector_resize(vtemp,0);
+	o2scl::vector_resize(vtemp2,0);
+	o2scl::vector_resize(vtemp3,0);
+	o2scl::vector_resize(vtemp4,0);
       }
     }
 
@@ -148,10 +180,10 @@ namespace o2scl {
     void allocate(size_t n) {
       if (n!=mem_size) {
 	free();
-	vtemp.resize(n);
-	vtemp2.resize(n);
-	vtemp3.resize(n);
-	vtemp4.resize(n);
+	o2scl::vector_resize(vtemp,n);
+	o2scl::vector_resize(vtemp2,n);
+	o2scl::vector_resize(vtemp3,n);
+	o2scl::vector_resize(vtemp4,n);
 	mem_size=n;
       }
     }
@@ -168,6 +200,8 @@ namespace o2scl {
       exit_on_fail=true;
       mem_size=0;
       err_nonconv=true;
+      dense_rec=false;
+      dense_nv=0;
     }
       
     virtual ~ode_iv_solve() {
@@ -304,6 +338,12 @@ namespace o2scl {
 
       // Compute initial derivative
       derivs(x,n,yend,dydx_start);
+
+      // Record the initial point for dense output
+      if (dense_rec) {
+	for(size_t i=0;i<n;i++) yerr[i]=0.0;
+	dense_push(x,n,yend,dydx_start,yerr);
+      }
       
       bool done=false;
       while (done==false) {
@@ -321,6 +361,8 @@ namespace o2scl {
 	  }
 	}
 
+	if (dense_rec && ret==0) dense_push(xnext,n,yend,dydx_end,yerr);
+
 	// Print out verbose info 
 	if (verbose>0 && xnext>xverb) {
 	  print_iter(xnext,n,yend);
@@ -365,6 +407,10 @@ namespace o2scl {
 	    }
 	  }
 
+	  if (dense_rec && ret==0) {
+	    dense_push(x,n,ystart,dydx_start,yerr);
+	  }
+
 	  // Print out verbose info 
 	  if (verbose>0 && x>xverb) {
 	    print_iter(x,n,ystart);
@@ -607,6 +653,180 @@ namespace o2scl {
     }
     //@}
 
+    /// \name Dense output
+    //@{
+    /** \brief Solve the initial-value problem and store the 
+	solution at each step for dense output
+
+	This function performs exactly the same integration as
+	solve_final_value(), and additionally records the function
+	values, derivatives, and errors at the end of every
+	adaptive step, so that the solution can be subsequently
+	evaluated at any point between \c x0 and \c x1 using
+	dense_eval(). The step sizes are not constrained by the
+	points at which the solution will be evaluated.
+    */
+    int solve_dense(double x0, double x1, double h, size_t n,
+		    vec_t &ystart, vec_t &yend, vec_t &yerr, 
+		    vec_t &dydx_end, func_t &derivs) {
+      dense_x.clear();
+      dense_y.clear();
+      dense_dydx.clear();
+      dense_yerr.clear();
+      dense_nv=n;
+      dense_rec=true;
+      int ret;
+      try {
+	ret=solve_final_value(x0,x1,h,n,ystart,yend,yerr,dydx_end,derivs);
+      } catch (...) {
+	dense_rec=false;
+	throw;
+      }
+      dense_rec=false;
+      return ret;
+    }
+
+    /** \brief Evaluate the solution stored by solve_dense() at \c x
+
+	The function values and derivatives at \c x are computed
+	from the cubic Hermite interpolant of the function values and
+	derivatives at the ends of the adaptive step which contains
+	\c x, so no additional derivative evaluations are required.
+	The interpolant is third-order accurate, which is lower than
+	the order of the stepper, so the error in the interpolated
+	values may be larger than that of the values at the ends of
+	each step. At the end of each step the stored values are
+	returned exactly.
+
+	The error handler is called if no solution has been stored
+	or if \c x is outside of the integration interval.
+    */
+    int dense_eval(double x, vec_t &y, vec_t &dydx) {
+
+      size_t np=dense_x.size();
+      if (np<2) {
+	O2SCL_ERR2("No stored solution in ",
+		   "ode_iv_solve::dense_eval().",exc_einval);
+      }
+      double xa=dense_x[0], xb=dense_x[np-1];
+      bool incr=(xb>xa);
+      if ((incr && (x<xa || x>xb)) || (!incr && (x>xa || x<xb))) {
+	std::string str="Point x="+o2scl::dtos(x)+" outside of interval ["+
+	  o2scl::dtos(xa)+","+o2scl::dtos(xb)+
+	  "] in ode_iv_solve::dense_eval().";
+	O2SCL_ERR(str.c_str(),exc_einval);
+      }
+
+      // Find the step which contains x by bisection
+      size_t lo=0, hi=np-1;
+      while (hi-lo>1) {
+	size_t mid=(lo+hi)/2;
+	if ((incr && dense_x[mid]<=x) || (!incr && dense_x[mid]>=x)) {
+	  lo=mid;
+	} else {
+	  hi=mid;
+	}
+      }
+
+      // Cubic Hermite interpolation over the step [lo,hi]
+      double hs=dense_x[hi]-dense_x[lo];
+      double t=(x-dense_x[lo])/hs;
+      double t2=t*t, u=1.0-t;
+      double h00=(1.0+2.0*t)*u*u, h10=t*u*u;
+      double h01=t2*(3.0-2.0*t), h11=t2*(t-1.0);
+      double d00=6.0*t2-6.0*t, d10=3.0*t2-4.0*t+1.0;
+      double d11=3.0*t2-2.0*t;
+      
+      size_t n=dense_nv;
+      const double *ya=&dense_y[lo*n], *yb=&dense_y[hi*n];
+      const double *da=&dense_dydx[lo*n], *db=&dense_dydx[hi*n];
+      for(size_t i=0;i<n;i++) {
+	y[i]=h00*ya[i]+h10*hs*da[i]+h01*yb[i]+h11*hs*db[i];
+	dydx[i]=d00*(ya[i]-yb[i])/hs+d10*da[i]+d11*db[i];
+      }
+
+      return 0;
+    }
+
+    /** \brief Evaluate the function values stored by solve_dense()
+	at \c x
+    */
+    int dense_eval(double x, vec_t &y) {
+      allocate(dense_nv);
+      return dense_eval(x,y,vtemp);
+    }
+
+    /// Return the number of points stored by solve_dense()
+    size_t dense_size() {
+      return dense_x.size();
+    }
+
+    /** \brief Solve the initial-value problem over a grid using
+	dense output
+
+	Initially, \c xsol should be a vector of size \c nsol
+	containing a monotonic grid of points, and \c ysol should be
+	a matrix of size \c [nsol][n] with the initial values in the
+	first row. In contrast to ode_iv_solve_grid::solve_grid(),
+	the adaptive steps are not shortened to land on the grid
+	points. Instead, the solution is computed as in solve_dense()
+	and then evaluated at each grid point with dense_eval().
+	The error in \c err_sol is that from the adaptive step
+	containing each grid point.
+	If solve_dense() returns a non-zero value, then that value
+	is returned and only the first row of \c ysol is set.
+
+	This template function works with any matrix class \c mat_t
+	which can be accessed using <tt>operator(size_t,size_t)</tt>.
+    */
+    template<class mat_t>
+    int solve_grid(double h, size_t n, size_t nsol, vec_t &xsol, 
+		   mat_t &ysol, mat_t &err_sol, mat_t &dydx_sol, 
+		   func_t &derivs) {
+
+      if (nsol<2) {
+	O2SCL_ERR2("Grid must have at least two points in ",
+		   "ode_iv_solve::solve_grid().",exc_einval);
+      }
+
+      double x0=xsol[0], x1=xsol[nsol-1];
+
+      vec_t ystart, yend, yerr, dydx_end;
+      o2scl::vector_resize(ystart,n);
+      o2scl::vector_resize(yend,n);
+      o2scl::vector_resize(yerr,n);
+      o2scl::vector_resize(dydx_end,n);
+      for(size_t j=0;j<n;j++) ystart[j]=ysol(0,j);
+
+      int ret=solve_dense(x0,x1,h,n,ystart,yend,yerr,dydx_end,derivs);
+      if (ret!=0) return ret;
+
+      // The first row
+      for(size_t j=0;j<n;j++) {
+	dydx_sol(0,j)=dense_dydx[j];
+	err_sol(0,j)=0.0;
+      }
+
+      // The remaining rows
+      size_t np=dense_x.size();
+      size_t k=1;
+      for(size_t i=1;i<nsol;i++) {
+	dense_eval(xsol[i],ystart,dydx_end);
+	// Find the step which contains this grid point to 
+	// obtain the error
+	while (k<np-1 && ((x1>x0 && dense_x[k]<xsol[i]) ||
+			  (x1<x0 && dense_x[k]>xsol[i]))) k++;
+	for(size_t j=0;j<n;j++) {
+	  ysol(i,j)=ystart[j];
+	  dydx_sol(i,j)=dydx_end[j];
+	  err_sol(i,j)=dense_yerr[k*n+j];
+	}
+      }
+
+      return ret;
+    }
+    //@}
+
     /// Set output level
     int verbose;
   
@@ -722,10 +942,10 @@ namespace o2scl {
 	point will be written to \c std::cout. If \ref verbose is
 	greater than one, a character will be required after each point.
 
-	\future Consider making a version of grid which gives the 
-	same answers as solve_final_value(). After each proposed step,
-	it would go back and fill in the grid points if the proposed
-	step was past the next grid point.
+	\note The function ode_iv_solve::solve_grid() gives the same
+	answers as ode_iv_solve::solve_final_value() and fills in
+	the grid points using dense output instead of shortening
+	the steps.
     */
     template<class vec_t, class mat_t>
     int solve_grid(double h, size_t n, size_t nsol, vec_t &xsol, 
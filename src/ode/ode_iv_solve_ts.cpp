@@ -229,6 +229,93 @@ int main(void) {
 
   cout << endl;
 
+  // ------------------------------------------------
+  // Dense output
+
+  cout << "Dense output: " << endl;
+  {
+    y[0]=1.0;
+    y[1]=(2.0/cos(1.0)+tan(1.0));
+    ubvector yend2(2), yerr2(2), dydx2(2);
+    ivs.solve_final_value(0.0,1.0,0.1,2,y,yend,yerr,dydx,od);
+    size_t ns_final=ivs.nsteps;
+    // The initial values are modified by solve_final_value()
+    y[0]=1.0;
+    y[1]=(2.0/cos(1.0)+tan(1.0));
+    ivs.solve_dense(0.0,1.0,0.1,2,y,yend2,yerr2,dydx2,od);
+    t.test_gen(ivs.nsteps==ns_final,"dense nsteps");
+    t.test_gen(ivs.dense_size()==ns_final+1,"dense size");
+    t.test_rel(yend2[0],yend[0],1.0e-14,"dense final 1");
+    t.test_rel(yend2[1],yend[1],1.0e-14,"dense final 2");
+
+    // Evaluate at points which are not on the steps
+    for(double xe=0.0;xe<=1.0;xe+=0.0625) {
+      ivs.dense_eval(xe,yend2,dydx2);
+      exact_sol(xe,ey,edydx,ed2ydx2);
+      cout << xe << " " << yend2[0] << " " << ey << " "
+	   << dydx2[0] << " " << edydx << endl;
+      t.test_rel(yend2[0],ey,1.0e-5,"dense y");
+      t.test_rel(yend2[1],edydx,1.0e-5,"dense y'");
+      t.test_rel(dydx2[0],edydx,5.0e-4,"dense dydx");
+    }
+    ivs.dense_eval(1.0,yend2);
+    t.test_rel(yend2[0],yend[0],1.0e-14,"dense end");
+
+    // Compare solve_grid() with the exact solution
+    size_t ng=11;
+    ubvector xg(ng);
+    ubmatrix yg(ng,2), eg(ng,2), dg(ng,2);
+    for(size_t i=0;i<ng;i++) xg[i]=((double)i)/((double)(ng-1));
+    yg(0,0)=1.0;
+    yg(0,1)=(2.0/cos(1.0)+tan(1.0));
+    ivs.solve_grid(0.1,2,ng,xg,yg,eg,dg,od);
+    t.test_gen(ivs.nsteps==ns_final,"grid nsteps");
+    for(size_t i=0;i<ng;i++) {
+      exact_sol(xg[i],ey,edydx,ed2ydx2);
+      t.test_rel(yg(i,0),ey,1.0e-5,"grid y");
+      t.test_rel(dg(i,1),ed2ydx2,5.0e-4,"grid dydx");
+    }
+    t.test_rel(yg(ng-1,0),yend[0],1.0e-14,"grid end");
+  }
+
+  cout << endl;
+
+  // ------------------------------------------------
+  // Fixed-size vectors with an inlined derivative function
+
+  cout << "Fixed-size: " << endl;
+  {
+    typedef std::array<double,2> arr_t;
+    auto fl=[](double xx, size_t nv, const arr_t &yy, arr_t &dd) -> int {
+      dd[0]=yy[1];
+      dd[1]=-yy[0];
+      return 0;
+    };
+    typedef decltype(fl) fl_t;
+    
+    ode_iv_solve<fl_t,arr_t> ivs_fixed;
+    astep_gsl_fixed<2,fl_t> as_fixed;
+    ivs_fixed.set_astep(as_fixed);
+
+    arr_t ya, yenda, yerra, dydxa;
+    ya[0]=1.0;
+    ya[1]=(2.0/cos(1.0)+tan(1.0));
+    ivs_fixed.solve_final_value(0.0,1.0,0.1,2,ya,yenda,yerra,dydxa,fl);
+
+    y[0]=1.0;
+    y[1]=(2.0/cos(1.0)+tan(1.0));
+    ivs.solve_final_value(0.0,1.0,0.1,2,y,yend,yerr,dydx,od);
+
+    exact_sol(1.0,ey,edydx,ed2ydx2);
+    cout << yenda[0] << " " << yend[0] << " " << ey << endl;
+    t.test_gen(ivs_fixed.nsteps==ivs.nsteps,"fixed nsteps");
+    t.test_rel(yenda[0],yend[0],1.0e-14,"fixed 1");
+    t.test_rel(yenda[1],yend[1],1.0e-14,"fixed 2");
+    t.test_rel(yenda[0],ey,1.0e-7,"fixed exact");
+  }
+
+  cout << endl;
+
   // ------------------------------------------------
 
   t.report();
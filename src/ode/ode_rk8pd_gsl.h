@@ -47,6 +47,7 @@
 */
 
 #include <o2scl/ode_step.h>
+#include <o2scl/vector.h>
 #include <o2scl/err_hnd.h>
 
 #ifndef DOXYGEN_NO_O2NS
@@ -248,28 +249,44 @@ namespace o2scl {
     virtual int step(double x, double h, size_t n, vec_y_t &y, 
 		     vec_dydx_t &dydx, vec_y_t &yout, vec_yerr_t &yerr, 
 		     vec_dydx_t &dydx_out, func_t &derivs) {
-      
-      int ret=0;
-      size_t i;
-      
+
       if (ndim!=n) {
-	k2.resize(n);
-	k3.resize(n);
-	k4.resize(n);
-	k5.resize(n);
-	k6.resize(n);
-	k7.resize(n);
-	k8.resize(n);
-	k9.resize(n);
-	k10.resize(n);
-	k11.resize(n);
-	k12.resize(n);
-	k13.resize(n);
-	ytmp.resize(n);
+	o2scl::vector_resize(k2,n);
+	o2scl::vector_resize(k3,n);
+	o2scl::vector_resize(k4,n);
+	o2scl::vector_resize(k5,n);
+	o2scl::vector_resize(k6,n);
+	o2scl::vector_resize(k7,n);
+	o2scl::vector_resize(k8,n);
+	o2scl::vector_resize(k9,n);
+	o2scl::vector_resize(k10,n);
+	o2scl::vector_resize(k11,n);
+	o2scl::vector_resize(k12,n);
+	o2scl::vector_resize(k13,n);
+	o2scl::vector_resize(ytmp,n);
 	
 	ndim=n;
       }
 
+      return step_base(x,h,n,y,dydx,yout,yerr,dydx_out,derivs);
+    }
+
+    protected:
+
+    /** \brief Perform the step using a loop bound of type \c size2_t
+
+        This is called by \ref step() with <tt>size2_t=size_t</tt>
+        and by \ref ode_rk8pd_gsl_fixed with a compile-time constant,
+        which allows the loops over the components to be unrolled.
+    */
+    template<class size2_t>
+    int step_base(double x, double h, size2_t n, vec_y_t &y, 
+		  vec_dydx_t &dydx, vec_y_t &yout, vec_yerr_t &yerr, 
+		  vec_dydx_t &dydx_out, func_t &derivs) {
+
+      int ret=0;
+      size_t i;
+
       for (i=0;i<n;i++) {
 	ytmp[i]=y[i]+b21*h*dydx[i];
       }
@@ -386,6 +403,49 @@ namespace o2scl {
     
   };
   
+  /** \brief Fixed-size version of \ref ode_rk8pd_gsl for small systems
+
+      This stepper uses <tt>std::array<double,N></tt> for the
+      intermediate storage, so it never allocates memory, and uses
+      the compile-time size \c N for the loops over the components so
+      that they can be unrolled. The type \c func_t may be any
+      callable object with the signature of \ref ode_funct (for
+      example, <tt>decltype</tt> of a lambda), which allows the
+      compiler to inline the derivative function.
+
+      The number of equations given to \ref step() must be equal
+      to \c N.
+  */
+  template<size_t N, class func_t=std::function<int
+    (double,size_t,const std::array<double,N> &,std::array<double,N> &)> >
+    class ode_rk8pd_gsl_fixed :
+    public ode_rk8pd_gsl<std::array<double,N>,std::array<double,N>,
+    std::array<double,N>,func_t> {
+    
+  public:
+
+  /// Vector type
+  typedef std::array<double,N> vec_t;
+
+  /** \brief Perform an integration step
+
+      This performs the same computation as \ref
+      ode_rk8pd_gsl::step(), and calls the error handler if
+      \c n is not equal to \c N.
+  */
+  virtual int step(double x, double h, size_t n, vec_t &y, 
+		   vec_t &dydx, vec_t &yout, vec_t &yerr, 
+		   vec_t &dydx_out, func_t &derivs) {
+    if (n!=N) {
+      O2SCL_ERR2("Number of equations not equal to N in ",
+		 "ode_rk8pd_gsl_fixed::step().",exc_einval);
+    }
+    return this->step_base(x,h,std::integral_constant<size_t,N>(),
+			   y,dydx,yout,yerr,dydx_out,derivs);
+  }
+    
+  };
+
 #ifndef DOXYGEN_NO_O2NS
 }
 #endif
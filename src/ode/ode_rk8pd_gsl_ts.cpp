@@ -33,6 +33,8 @@
 #include <o2scl/ode_funct.h>
 #include <o2scl/ode_rk8pd_gsl.h>
 
+#include "ode_step_fixed_ts.h"
+
 using namespace std;
 using namespace o2scl;
 
@@ -83,6 +85,11 @@ int main(void) {
   }
   cout << endl;
   
+  // Compare the fixed-size stepper with a lambda to the generic one
+  test_step_fixed<ode_rk8pd_gsl_fixed,
+		  ode_rk8pd_gsl<ubvector,ubvector,ubvector,ode_funct> >
+    (t,"rk8pd");
+
   t.report();
 
   return 0;
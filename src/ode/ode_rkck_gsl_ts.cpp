@@ -33,6 +33,8 @@
 #include <o2scl/ode_funct.h>
 #include <o2scl/ode_rkck_gsl.h>
 
+#include "ode_step_fixed_ts.h"
+
 typedef boost::numeric::ublas::vector<double> ubvector;
 
 int expon(double x, size_t nv, const ubvector &y, ubvector &dydx) {
@@ -195,6 +197,11 @@ int main(void) {
     
   }
 
+  // Compare the fixed-size stepper with a lambda to the generic one
+  test_step_fixed<ode_rkck_gsl_fixed,
+		  ode_rkck_gsl<ubvector,ubvector,ubvector,ode_funct> >
+    (t,"rkck");
+
   t.report();
 
 
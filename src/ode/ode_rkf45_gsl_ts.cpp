@@ -31,6 +31,8 @@
 #include <o2scl/ode_funct.h>
 #include <o2scl/ode_rkf45_gsl.h>
 
+#include "ode_step_fixed_ts.h"
+
 typedef boost::numeric::ublas::vector<double> ubvector;
 
 int derivs(double x, size_t nv, const ubvector &y, ubvector &dydx) {
@@ -79,6 +81,11 @@ int main(void) {
   }
   cout << endl;
 
+  // Compare the fixed-size stepper with a lambda to the generic one
+  test_step_fixed<ode_rkf45_gsl_fixed,
+		  ode_rkf45_gsl<ubvector,ubvector,ubvector,ode_funct> >
+    (t,"rkf45");
+
   t.report();
 
   return 0;
@@ -0,0 +1,91 @@
+/*
+  -------------------------------------------------------------------
+  
+  Copyright (C) 2006-2019, Andrew W. Steiner
+  
+  This file is part of O2scl.
+  
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+  
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+/** \file ode_step_fixed_ts.h
+    \brief Shared test comparing a fixed-size stepper with the
+    corresponding generic stepper
+*/
+#ifndef O2SCL_ODE_STEP_FIXED_TS_H
+#define O2SCL_ODE_STEP_FIXED_TS_H
+
+#include <array>
+#include <cmath>
+#include <string>
+
+#include <boost/numeric/ublas/vector.hpp>
+
+#include <o2scl/test_mgr.h>
+#include <o2scl/ode_funct.h>
+
+/** \brief Compare the fixed-size stepper \c fixed_t using a lambda 
+    with the generic stepper \c gen_t
+
+    Both steppers take 20 steps of a coupled nonlinear system with
+    three components, so every stage of the Runge-Kutta tableau
+    contributes to each component. The function values and errors
+    from the two steppers must agree to within roundoff.
+*/
+template<template<size_t,class> class fixed_t, class gen_t>
+void test_step_fixed(o2scl::test_mgr &t, std::string name) {
+
+  typedef boost::numeric::ublas::vector<double> ubvector;
+  typedef std::array<double,3> arr_t;
+
+  auto fl=[](double xx, size_t nv, const arr_t &yy, arr_t &dd) -> int {
+    dd[0]=yy[1];
+    dd[1]=-yy[0];
+    dd[2]=-yy[0]*yy[2]+xx;
+    return 0;
+  };
+  o2scl::ode_funct og=[](double xx, size_t nv, const ubvector &yy,
+			 ubvector &dd) -> int {
+    dd[0]=yy[1];
+    dd[1]=-yy[0];
+    dd[2]=-yy[0]*yy[2]+xx;
+    return 0;
+  };
+
+  fixed_t<3,decltype(fl)> rkf;
+  gen_t rkg;
+  
+  arr_t ya={1.0,0.0,1.0}, da, ea;
+  ubvector yg(3), dg(3), eg(3);
+  for(size_t i=0;i<3;i++) yg[i]=ya[i];
+  double xf=0.0;
+  fl(xf,3,ya,da);
+  og(xf,3,yg,dg);
+  for(size_t i=0;i<20;i++) {
+    rkf.step(xf,0.1,3,ya,da,ya,ea,da,fl);
+    rkg.step(xf,0.1,3,yg,dg,yg,eg,dg,og);
+    xf+=0.1;
+  }
+  for(size_t i=0;i<3;i++) {
+    t.test_rel(ya[i],yg[i],1.0e-14,name+" fixed vs. generic y");
+    t.test_rel(da[i],dg[i],1.0e-14,name+" fixed vs. generic dydx");
+    t.test_rel(ea[i],eg[i],1.0e-12,name+" fixed vs. generic err");
+  }
+  t.test_rel(ya[0],cos(xf),1.0e-6,name+" fixed vs. exact");
+
+  return;
+}
+
+#endif
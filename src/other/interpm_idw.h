@@ -30,6 +30,8 @@
 #include <iostream>
 #include <string>
 #include <cmath>
+#include <algorithm>
+#include <utility>
 
 #include <boost/numeric/ublas/matrix.hpp>
 
@@ -104,6 +106,17 @@ namespace o2scl {
       time required to compute the nearest points which are
       nondegenerate.
 
+      By default, each interpolation computes the distance to every
+      point in the data set. If \ref use_tree is true when \ref
+      set_data() is called (or if \ref build_tree() is called
+      afterwards), then a k-d tree is constructed over the input
+      coordinates so that the nearest points can be found in a time
+      which grows only logarithmically with the number of points.
+      The tree does not depend on the length scales, so they can be
+      changed without rebuilding the tree, but it must be rebuilt
+      with \ref build_tree() if the data is modified. The tree is
+      only used when \ref dist_expo is equal to 2.
+
       \todo Make verbose output consistent between the various
       eval() functions.
 
@@ -129,6 +142,7 @@ namespace o2scl {
     n_extra=0;
     min_dist=1.0e-6;
     dist_expo=2.0;
+    use_tree=false;
   }
 
   /** \brief Exponent in computing distance (default 2.0)
@@ -149,6 +163,11 @@ namespace o2scl {
   */
   double min_dist;
 
+  /** \brief If true, construct a k-d tree in \ref set_data()
+      (default false)
+  */
+  bool use_tree;
+
   /// \name Get and set functions
   //@{
   /** \brief Set the number of closest points to use
@@ -217,9 +236,50 @@ namespace o2scl {
       auto_scale();
     }
 
+    if (use_tree) {
+      build_tree();
+    } else {
+      clear_tree();
+    }
+
+    return;
+  }
+
+  /** \brief Construct the k-d tree used to find the nearest
+      points
+
+      Each node divides its points at the median of the input
+      coordinate with the largest spread (relative to the length
+      scales at the time the tree is built), until there are at
+      most \ref tree_leaf_size points in each leaf.
+  */
+  void build_tree() {
+    
+    if (data_set==false) {
+      O2SCL_ERR("Data not set in interpm_idw::build_tree().",
+		exc_einval);
+    }
+    
+    tree_perm.resize(np);
+    for(size_t i=0;i<np;i++) tree_perm[i]=i;
+    tree_nodes.clear();
+    tree_build_node(0,np);
+    
+    return;
+  }
+
+  /// Free the memory associated with the k-d tree
+  void clear_tree() {
+    tree_perm.clear();
+    tree_nodes.clear();
     return;
   }
 
+  /// Return true if the k-d tree has been constructed
+  bool tree_built() const {
+    return tree_nodes.size()>0;
+  }
+
   /** \brief Get the data used for interpolation
    */
   void get_data(size_t &n_in, size_t &n_out, size_t &n_points,
@@ -229,6 +289,7 @@ namespace o2scl {
     n_out=nd_out;
     std::swap(data,dat);
     data_set=false;
+    clear_tree();
     n_points=0;
     n_in=0;
     n_out=0;
@@ -284,50 +345,26 @@ namespace o2scl {
 		exc_einval);
     }
     
-    // Compute distances
-    std::vector<double> dists(np);
-    for(size_t i=0;i<np;i++) {
-      dists[i]=dist(i,x);
-    }
-
     // Find closest points
     std::vector<size_t> index;
-    o2scl::vector_smallest_index<std::vector<double>,double,
-    std::vector<size_t> >(dists,points+n_extra,index);
-
-    if (n_extra>0) {
-      // Remove degenerate points to ensure accurate interpolation
-      bool found=true;
-      while (found==true) {
-	found=false;
-	// Find degenerate points and remove them
-	for(size_t j=0;j<points+n_extra;j++) {
-	  for(size_t k=j;k<points+n_extra;k++) {
-	    double dist_jk=dist(j,k);
-	    if (index.size()>points && dist_jk<min_dist) {
-	      found=true;
-	      index.erase(index.begin()+j);
-	    }
-	  }
-	}
-      }
-    }
-      
+    std::vector<double> dists;
+    nearest(x,points,index,dists);
+
     // Check if the closest distance is zero
-    if (dists[index[0]]<=0.0) {
+    if (dists[0]<=0.0) {
       return data(nd_in,index[0]);
     }
 
     // Compute normalization
     double norm=0.0;
     for(size_t i=0;i<points;i++) {
-      norm+=1.0/dists[index[i]];
+      norm+=1.0/dists[i];
     }
 
     // Compute the inverse-distance weighted average
     double ret=0.0;
     for(size_t i=0;i<points;i++) {
-      ret+=data(nd_in,index[i])/dists[index[i]];
+      ret+=data(nd_in,index[i])/dists[i];
     }
     ret/=norm;
 
@@ -346,36 +383,12 @@ namespace o2scl {
 		exc_einval);
     }
       
-    // Compute distances
-    std::vector<double> dists(np);
-    for(size_t i=0;i<np;i++) {
-      dists[i]=dist(i,x);
-    }
-
     // Find closest points
     std::vector<size_t> index;
-    o2scl::vector_smallest_index<std::vector<double>,double,
-    std::vector<size_t> >(dists,points+1+n_extra,index);
-
-    if (n_extra>0) {
-      // Remove degenerate points to ensure accurate interpolation
-      bool found=true;
-      while (found==true) {
-	found=false;
-	// Find degenerate points and remove them
-	for(size_t j=0;j<points+1+n_extra;j++) {
-	  for(size_t k=j;k<points+1+n_extra;k++) {
-	    double dist_jk=dist(j,k);
-	    if (index.size()>points+1 && dist_jk<min_dist) {
-	      found=true;
-	      index.erase(index.begin()+j);
-	    }
-	  }
-	}
-      }
-    }
-      
-    if (dists[index[0]]<=0.0) {
+    std::vector<double> dists;
+    nearest(x,points+1,index,dists);
+
+    if (dists[0]<=0.0) {
 
       // If the closest distance is zero, just set the value
       val=data(nd_in,index[0]);
@@ -391,14 +404,14 @@ namespace o2scl {
 	// Compute normalization
 	double norm=0.0;
 	for(size_t i=0;i<points+1;i++) {
-	  if (i!=j) norm+=1.0/dists[index[i]];
+	  if (i!=j) norm+=1.0/dists[i];
 	}
 	  
 	// Compute the inverse-distance weighted average
 	vals[j]=0.0;
 	for(size_t i=0;i<points+1;i++) {
 	  if (i!=j) {
-	    vals[j]+=data(nd_in,index[i])/dists[index[i]];
+	    vals[j]+=data(nd_in,index[i])/dists[i];
 	  }
 	}
 	vals[j]/=norm;
@@ -432,16 +445,10 @@ namespace o2scl {
       std::cout << std::endl;
     }
       
-    // Compute distances
-    std::vector<double> dists(np);
-    for(size_t i=0;i<np;i++) {
-      dists[i]=dist(i,x);
-    }
-
     // Find closest points
     std::vector<size_t> index;
-    o2scl::vector_smallest_index<std::vector<double>,double,
-    std::vector<size_t> >(dists,points,index);
+    std::vector<double> dists;
+    nearest(x,points,index,dists);
     if (verbose>0) {
       for(size_t i=0;i<points;i++) {
 	std::cout << "interpm_idw: closest point: ";
@@ -452,27 +459,9 @@ namespace o2scl {
       }
     }
       
-    if (n_extra>0) {
-      // Remove degenerate points to ensure accurate interpolation
-      bool found=true;
-      while (found==true) {
-	found=false;
-	// Find degenerate points and remove them
-	for(size_t j=0;j<points+n_extra;j++) {
-	  for(size_t k=j;k<points+n_extra;k++) {
-	    double dist_jk=dist(j,k);
-	    if (index.size()>points && dist_jk<min_dist) {
-	      found=true;
-	      index.erase(index.begin()+j);
-	    }
-	  }
-	}
-      }
-    }
-      
     // Check if the closest distance is zero, if so, just
     // return the value
-    if (dists[index[0]]<=0.0) {
+    if (dists[0]<=0.0) {
       for(size_t i=0;i<nd_out;i++) {
 	y[i]=data(nd_in+i,index[0]);
       }
@@ -488,7 +477,7 @@ namespace o2scl {
     // Compute normalization
     double norm=0.0;
     for(size_t i=0;i<points;i++) {
-      norm+=1.0/dists[index[i]];
+      norm+=1.0/dists[i];
     }
     if (verbose>0) {
       std::cout << "interpm_idw: norm is " << norm << std::endl;
@@ -505,12 +494,12 @@ namespace o2scl {
 	  }
 	  std::cout << std::endl;
 	}
-	y[j]+=data(nd_in+j,index[i])/dists[index[i]];
+	y[j]+=data(nd_in+j,index[i])/dists[i];
 	if (verbose>0) {
 	  std::cout << "interpm_idw: j,points,value,1/dist: "
 		    << j << " " << i << " "
 		    << data(nd_in+j,index[i]) << " "
-		    << 1.0/dists[index[i]] << std::endl;
+		    << 1.0/dists[i] << std::endl;
 	}
       }
       y[j]/=norm;
@@ -522,13 +511,71 @@ namespace o2scl {
 
     return;
   }
+
+  /** \brief Perform the interpolation over all the functions
+      for \c n points
+
+      The coordinates of point \c i are given in 
+      <tt>x(i,0)</tt> through <tt>x(i,n_in-1)</tt>, and the
+      results are stored in <tt>y(i,0)</tt> through 
+      <tt>y(i,n_out-1)</tt>. If <tt>O2SCL_OPENMP</tt> is
+      defined, the points are distributed among the OpenMP
+      threads. The verbose output from \ref eval() is 
+      not produced by this function.
+  */
+  template<class mat2_t, class mat3_t>
+  void eval_batch(size_t n, const mat2_t &x, mat3_t &y) const {
+    
+    if (data_set==false) {
+      O2SCL_ERR("Data not set in interpm_idw::eval_batch().",
+		exc_einval);
+    }
+    
+#ifdef O2SCL_OPENMP
+#pragma omp parallel default(shared)
+#endif
+    {
+      std::vector<double> xi(nd_in), dists;
+      std::vector<size_t> index;
+      
+#ifdef O2SCL_OPENMP
+#pragma omp for
+#endif
+      for(size_t ip=0;ip<n;ip++) {
+	
+	for(size_t k=0;k<nd_in;k++) xi[k]=x(ip,k);
+	nearest(xi,points,index,dists);
+	
+	if (dists[0]<=0.0) {
+	  for(size_t j=0;j<nd_out;j++) {
+	    y(ip,j)=data(nd_in+j,index[0]);
+	  }
+	} else {
+	  double norm=0.0;
+	  for(size_t i=0;i<points;i++) {
+	    norm+=1.0/dists[i];
+	  }
+	  for(size_t j=0;j<nd_out;j++) {
+	    double sum=0.0;
+	    for(size_t i=0;i<points;i++) {
+	      sum+=data(nd_in+j,index[i])/dists[i];
+	    }
+	    y(ip,j)=sum/norm;
+	  }
+	}
+      }
+    }
+    
+    return;
+  }
     
   /** \brief Perform the interpolation over all the functions
       giving uncertainties and the sorted index vector 
 
       The vector \c index is automatically resized to
-      a size equal to n_points+1+n_extra
-      be larger than 
+      a size equal to <tt>n_points+1</tt> and contains
+      the indices of the closest points in order of 
+      increasing distance.
   */
   template<class vec2_t, class vec3_t, class vec4_t>
   void eval_err_index(const vec2_t &x, vec3_t &val, vec4_t &err,
@@ -539,36 +586,11 @@ namespace o2scl {
 		exc_einval);
     }
       
-    // Compute distances
-    std::vector<double> dists(np);
-    for(size_t i=0;i<np;i++) {
-      dists[i]=dist(i,x);
-    }
-
-    // Find closest points, note that index is automatically resized
-    // by the vector_smallest_index function
-    o2scl::vector_smallest_index<std::vector<double>,double,
-    std::vector<size_t> >(dists,points+1+n_extra,index);
-
-    if (n_extra>0) {
-      // Remove degenerate points to ensure accurate interpolation
-      bool found=true;
-      while (found==true) {
-	found=false;
-	// Find degenerate points and remove them
-	for(size_t j=0;j<points+1+n_extra;j++) {
-	  for(size_t k=j;k<points+1+n_extra;k++) {
-	    double dist_jk=dist(j,k);
-	    if (index.size()>points+1 && dist_jk<min_dist) {
-	      found=true;
-	      index.erase(index.begin()+j);
-	    }
-	  }
-	}
-      }
-    }
+    // Find closest points
+    std::vector<double> dists;
+    nearest(x,points+1,index,dists);
 
-    if (dists[index[0]]<=0.0) {
+    if (dists[0]<=0.0) {
 
       // If the closest distance is zero, just set the values and
       // errors
@@ -589,14 +611,14 @@ namespace o2scl {
 	  // Compute normalization
 	  double norm=0.0;
 	  for(size_t i=0;i<points+1;i++) {
-	    if (i!=j) norm+=1.0/dists[index[i]];
+	    if (i!=j) norm+=1.0/dists[i];
 	  }
 	    
 	  // Compute the inverse-distance weighted average
 	  vals[j]=0.0;
 	  for(size_t i=0;i<points+1;i++) {
 	    if (i!=j) {
-	      vals[j]+=data(nd_in+k,index[i])/dists[index[i]];
+	      vals[j]+=data(nd_in+k,index[i])/dists[i];
 	    }
 	  }
 	  vals[j]/=norm;
@@ -664,15 +686,10 @@ namespace o2scl {
     // The linear solver
     o2scl_linalg::linear_solver_HH<> lshh;
     
-    // Compute distances
-    std::vector<double> dists(np);
-    for(size_t i=0;i<np;i++) {
-      dists[i]=dist(i,x);
-    }
-  
     // Find closest (but not identical) points
 
     std::vector<size_t> index;
+    std::vector<double> dists;
     size_t max_smallest=(nd_in+2)*2;
     if (max_smallest>np) max_smallest=np;
     if (max_smallest<nd_in+1) {
@@ -683,20 +700,21 @@ namespace o2scl {
       std::cout << "max_smallest: " << max_smallest << std::endl;
     }
       
-    o2scl::vector_smallest_index<std::vector<double>,double,
-    std::vector<size_t> >(dists,max_smallest,index);
+    nearest(x,max_smallest,index,dists,false);
 
     if (verbose>0) {
       for(size_t i=0;i<index.size();i++) {
 	std::cout << "index[" << i << "] = " << index[i] << " "
-		  << dists[index[i]] << std::endl;
+		  << dists[i] << std::endl;
       }
     }
       
     std::vector<size_t> index2;
+    std::vector<double> dists2;
     for(size_t i=0;i<max_smallest;i++) {
-      if (dists[index[i]]>0.0) {
+      if (dists[i]>0.0) {
 	index2.push_back(index[i]);
+	dists2.push_back(dists[i]);
 	if (index2.size()==nd_in+1) i=max_smallest;
       }
     }
@@ -708,7 +726,7 @@ namespace o2scl {
     if (verbose>0) {
       for(size_t i=0;i<index2.size();i++) {
 	std::cout << "index2[" << i << "] = " << index2[i] << " "
-	<< dists[index2[i]] << std::endl;
+	<< dists2[i] << std::endl;
       }
     }
       
@@ -864,6 +882,212 @@ namespace o2scl {
     }
     return sqrt(ret);
   }
+
+  /** \brief Find the \c n_req points closest to \c x
+
+      This stores the indices of the closest points in order of
+      increasing distance in \c index and their distances in \c
+      dists. If \c remove_degen is true and \ref n_extra is
+      nonzero, then <tt>n_req+n_extra</tt> points are found and
+      points which are closer than \ref min_dist to a closer point
+      in the list are removed, as long as \c n_req points remain.
+  */
+  template<class vec2_t>
+  void nearest(const vec2_t &x, size_t n_req, std::vector<size_t> &index,
+	       std::vector<double> &dists, bool remove_degen=true) const {
+
+    size_t n_find=n_req;
+    if (remove_degen) n_find+=n_extra;
+    if (n_find>np) n_find=np;
+    
+    if (tree_built() && dist_expo==2.0) {
+      
+      // Search the k-d tree, keeping the points found so far 
+      // in a max-heap ordered by distance
+      std::vector<std::pair<double,size_t> > heap;
+      heap.reserve(n_find+1);
+      tree_search(0,x,n_find,heap);
+      std::sort_heap(heap.begin(),heap.end());
+      index.resize(heap.size());
+      dists.resize(heap.size());
+      for(size_t i=0;i<heap.size();i++) {
+	dists[i]=heap[i].first;
+	index[i]=heap[i].second;
+      }
+      
+    } else {
+      
+      std::vector<double> all(np);
+      for(size_t i=0;i<np;i++) {
+	all[i]=dist(i,x);
+      }
+      o2scl::vector_smallest_index<std::vector<double>,double,
+	std::vector<size_t> >(all,n_find,index);
+      dists.resize(n_find);
+      for(size_t i=0;i<n_find;i++) {
+	dists[i]=all[index[i]];
+      }
+      
+    }
+    
+    if (remove_degen && n_extra>0 && index.size()>n_req) {
+      
+      // Remove degenerate points, always keeping the closest
+      size_t n_keep=1;
+      for(size_t j=1;j<index.size() && n_keep<n_req;j++) {
+	bool degen=false;
+	// Only remove points if enough candidates remain
+	if (index.size()-j>n_req-n_keep) {
+	  for(size_t k=0;k<n_keep && degen==false;k++) {
+	    if (dist(index[j],index[k])<min_dist) degen=true;
+	  }
+	}
+	if (!degen) {
+	  index[n_keep]=index[j];
+	  dists[n_keep]=dists[j];
+	  n_keep++;
+	}
+      }
+      index.resize(n_keep);
+      dists.resize(n_keep);
+      
+    } else if (index.size()>n_req) {
+      
+      index.resize(n_req);
+      dists.resize(n_req);
+      
+    }
+    
+    return;
+  }
+  //@}
+
+  /// \name k-d tree [protected]
+  //@{
+  /// A node in the k-d tree
+  typedef struct {
+    /// The splitting dimension, or -1 for a leaf
+    int dim;
+    /// The value of the coordinate used to split the node
+    double split;
+    /// The index of the node with the smaller values
+    size_t left;
+    /// The index of the node with the larger values
+    size_t right;
+    /// The first point in \ref tree_perm for a leaf
+    size_t begin;
+    /// One past the last point in \ref tree_perm for a leaf
+    size_t end;
+  } tree_node;
+
+  /// Maximum number of points in a leaf of the k-d tree
+  static const size_t tree_leaf_size=8;
+
+  /// The nodes in the k-d tree, with the root first
+  std::vector<tree_node> tree_nodes;
+
+  /// The data point indices, ordered so that each leaf is contiguous
+  std::vector<size_t> tree_perm;
+
+  /** \brief Recursively construct the node for the points 
+      <tt>tree_perm[begin]</tt> to <tt>tree_perm[end-1]</tt> and
+      return its index
+  */
+  size_t tree_build_node(size_t begin, size_t end) {
+    
+    size_t inode=tree_nodes.size();
+    tree_nodes.push_back(tree_node());
+    tree_nodes[inode].begin=begin;
+    tree_nodes[inode].end=end;
+    tree_nodes[inode].dim=-1;
+    tree_nodes[inode].split=0.0;
+    tree_nodes[inode].left=0;
+    tree_nodes[inode].right=0;
+    
+    if (end-begin<=tree_leaf_size) return inode;
+
+    // Find the dimension with the largest scaled spread
+    size_t nscales=scales.size();
+    int best_dim=-1;
+    double best_spread=0.0;
+    for(size_t k=0;k<nd_in;k++) {
+      double lo=data(k,tree_perm[begin]), hi=lo;
+      for(size_t i=begin+1;i<end;i++) {
+	double v=data(k,tree_perm[i]);
+	if (v<lo) lo=v;
+	if (v>hi) hi=v;
+      }
+      double spread=(hi-lo)/scales[k%nscales];
+      if (spread>best_spread) {
+	best_spread=spread;
+	best_dim=k;
+      }
+    }
+    
+    // If all of the points are identical, make this a leaf
+    if (best_dim<0) return inode;
+
+    // Split at the median
+    size_t mid=begin+(end-begin)/2;
+    size_t dim=best_dim;
+    std::nth_element(tree_perm.begin()+begin,tree_perm.begin()+mid,
+		     tree_perm.begin()+end,
+		     [this,dim](size_t a, size_t b) {
+		       return data(dim,a)<data(dim,b);
+		     });
+    double split=data(dim,tree_perm[mid]);
+
+    size_t left=tree_build_node(begin,mid);
+    size_t right=tree_build_node(mid,end);
+    tree_nodes[inode].dim=best_dim;
+    tree_nodes[inode].split=split;
+    tree_nodes[inode].left=left;
+    tree_nodes[inode].right=right;
+    
+    return inode;
+  }
+
+  /** \brief Search the node with index \c inode for points
+      closer to \c x than those in \c heap
+  */
+  template<class vec2_t>
+  void tree_search(size_t inode, const vec2_t &x, size_t n_find,
+		   std::vector<std::pair<double,size_t> > &heap) const {
+
+    const tree_node &node=tree_nodes[inode];
+    
+    if (node.dim<0) {
+      for(size_t i=node.begin;i<node.end;i++) {
+	size_t ix=tree_perm[i];
+	double d=dist(ix,x);
+	if (heap.size()<n_find) {
+	  heap.push_back(std::make_pair(d,ix));
+	  std::push_heap(heap.begin(),heap.end());
+	} else if (d<heap.front().first) {
+	  std::pop_heap(heap.begin(),heap.end());
+	  heap.back()=std::make_pair(d,ix);
+	  std::push_heap(heap.begin(),heap.end());
+	}
+      }
+      return;
+    }
+
+    // Search the side containing x first, and then the other side
+    // only if it might contain closer points
+    double diff=(x[node.dim]-node.split)/
+      scales[node.dim%scales.size()];
+    size_t first=node.left, second=node.right;
+    if (diff>=0.0) {
+      first=node.right;
+      second=node.left;
+    }
+    tree_search(first,x,n_find,heap);
+    if (heap.size()<n_find || fabs(diff)<=heap.front().first) {
+      tree_search(second,x,n_find,heap);
+    }
+    
+    return;
+  }
   //@}
     
 #endif
@@ -33,6 +33,7 @@ using namespace std;
 using namespace o2scl;
 
 typedef boost::numeric::ublas::vector<double> ubvector;
+typedef boost::numeric::ublas::matrix<double> ubmatrix;
 
 double ft(double x, double y, double z) {
   return 3.0-2.0*x*x+7.0*y*z-5.0*z*x;
@@ -217,6 +218,49 @@ int main(void) {
     cout << endl;
   }
 
+  cout << "Compare the k-d tree with the full search." << endl;
+  {
+    size_t N=20000;
+    std::vector<double> x3, y3, z3, f3;
+    for(size_t i=0;i<N;i++) {
+      x3.push_back(rg.random());
+      y3.push_back(rg.random()*10.0);
+      z3.push_back(rg.random());
+      f3.push_back(ft(x3[i],y3[i]/10.0,z3[i]));
+    }
+    std::vector<std::vector<double> > dat3(4), dat4;
+    dat3[0]=x3;
+    dat3[1]=y3;
+    dat3[2]=z3;
+    dat3[3]=f3;
+    dat4=dat3;
+    matrix_view_vec_vec<vector<double> > mv3c(dat3), mv3d(dat4);
+    
+    interpm_idw<matrix_view_vec_vec<vector<double> > > imi_full, imi_tree;
+    imi_tree.use_tree=true;
+    imi_full.set_data(3,1,N,mv3c);
+    imi_tree.set_data(3,1,N,mv3d);
+    t.test_gen(imi_tree.tree_built(),"tree built");
+
+    size_t nq=100;
+    ubmatrix pts(nq,3), res(nq,1);
+    for(size_t k=0;k<nq;k++) {
+      std::vector<double> p3={rg.random(),rg.random()*10.0,rg.random()};
+      for(size_t j=0;j<3;j++) pts(k,j)=p3[j];
+      double v1, v2, e1, e2;
+      imi_full.eval_err(p3,v1,e1);
+      imi_tree.eval_err(p3,v2,e2);
+      t.test_rel(v2,v1,1.0e-12,"tree vs. full");
+      t.test_rel(e2,e1,1.0e-10,"tree vs. full err");
+    }
+    imi_tree.eval_batch(nq,pts,res);
+    for(size_t k=0;k<nq;k++) {
+      std::vector<double> p3={pts(k,0),pts(k,1),pts(k,2)};
+      t.test_rel(res(k,0),imi_full.eval(p3),1.0e-12,"eval_batch");
+    }
+  }
+  cout << endl;
+
   t.report();
   return 0;
 }
@@ -31,6 +31,9 @@
 #include <iostream>
 #include <string>
 #include <cmath>
+#include <vector>
+#include <algorithm>
+#include <utility>
 
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/operation.hpp>
@@ -383,6 +386,22 @@ namespace o2scl {
       
       See also the \ref intp_section section of the \o2 User's guide. 
 
+      If \ref n_local is nonzero, then the dense covariance matrix
+      over all the data points is never constructed. Instead, each
+      call to eval() finds the \ref n_local points nearest to the
+      requested point (using the Euclidean distance in the possibly
+      rescaled coordinates) and solves a small kriging system with
+      only those points. The length scale is then chosen by
+      leave-one-out cross validation over \ref loo_npts points, each
+      predicted from its own nearest neighbors, regardless of the
+      value of \ref mode. This makes data sets with \f$ 10^5 \f$
+      points practical, at the cost of a result which is only
+      piecewise continuous.
+
+      The two-argument version of eval() evaluates the
+      squared-exponential covariance function directly rather than
+      through the function objects in \ref ff2.
+
       \note This class is experimental.
   */
   template<class vec_t=boost::numeric::ublas::vector<double>,
@@ -436,6 +455,146 @@ namespace o2scl {
 
   /// Pointer to the user-specified minimizer
   min_base<> *mp;
+
+  /// \name Storage for local kriging
+  //@{
+  /// Copy of the output data (only used if \ref n_local is nonzero)
+  std::vector<ubvector> y_local;
+  /// Noise variance for each output function
+  std::vector<double> noise_local;
+  /// The points used for cross validation
+  std::vector<size_t> loo_row;
+  /// The nearest neighbors of each cross validation point
+  std::vector<std::vector<size_t> > loo_nbr;
+  /// The squared distances to the neighbors in \ref loo_nbr
+  std::vector<std::vector<double> > loo_d2;
+  /// The average distance to the furthest cross validation neighbor
+  double loo_len_avg;
+  //@}
+
+  /** \brief Compute the squared distance between data points
+      \c i and \c j
+  */
+  double local_dist2(size_t i, size_t j) const {
+    double ret=0.0;
+    for(size_t k=0;k<this->nd_in;k++) {
+      double d=(this->x)(i,k)-(this->x)(j,k);
+      ret+=d*d;
+    }
+    return ret;
+  }
+
+  /** \brief Find the \c n_req data points nearest to \c x0,
+      excluding the point with index \c skip
+
+      The indices are stored in \c index and the squared distances
+      in \c d2, both sorted by increasing distance.
+  */
+  template<class vec2_t>
+  void local_nearest(const vec2_t &x0, size_t n_req, size_t skip,
+		     std::vector<size_t> &index,
+		     std::vector<double> &d2) const {
+
+    // Maintain a max-heap of the closest points found so far
+    std::vector<std::pair<double,size_t> > heap;
+    heap.reserve(n_req+1);
+    for(size_t i=0;i<this->np;i++) {
+      if (i==skip) continue;
+      double dist=0.0;
+      for(size_t k=0;k<this->nd_in && (heap.size()<n_req ||
+					 dist<heap.front().first);k++) {
+	double d=(this->x)(i,k)-x0[k];
+	dist+=d*d;
+      }
+      if (heap.size()<n_req) {
+	heap.push_back(std::make_pair(dist,i));
+	std::push_heap(heap.begin(),heap.end());
+      } else if (dist<heap.front().first) {
+	std::pop_heap(heap.begin(),heap.end());
+	heap.back()=std::make_pair(dist,i);
+	std::push_heap(heap.begin(),heap.end());
+      }
+    }
+    std::sort_heap(heap.begin(),heap.end());
+
+    index.resize(heap.size());
+    d2.resize(heap.size());
+    for(size_t i=0;i<heap.size();i++) {
+      d2[i]=heap[i].first;
+      index[i]=heap[i].second;
+    }
+    return;
+  }
+
+  /** \brief Solve the kriging system for the neighbors \c index
+      with squared distances \c d2 from the requested point
+
+      The matrix \c D2 holds the squared distances between the
+      neighbors and \c KXX and \c w are workspace. Returns a
+      nonzero value if the covariance matrix is not positive
+      definite.
+  */
+  int local_solve(size_t m, const std::vector<size_t> &index,
+		  const std::vector<double> &d2, const ubmatrix &D2,
+		  double xlen, double noise_var, size_t iout,
+		  ubmatrix &KXX, ubvector &w, double &ypred) const {
+    
+    double fac=-0.5/xlen/xlen;
+    for(size_t irow=0;irow<m;irow++) {
+      KXX(irow,irow)=1.0+noise_var;
+      for(size_t icol=irow+1;icol<m;icol++) {
+	KXX(irow,icol)=exp(D2(irow,icol)*fac);
+	KXX(icol,irow)=KXX(irow,icol);
+      }
+      w[irow]=y_local[iout][index[irow]];
+    }
+    
+    int cret=o2scl_linalg::cholesky_decomp(m,KXX,false);
+    if (cret!=0) return cret;
+    o2scl_linalg::cholesky_svx(m,KXX,w);
+    
+    ypred=0.0;
+    for(size_t i=0;i<m;i++) {
+      ypred+=exp(d2[i]*fac)*w[i];
+    }
+    return 0;
+  }
+
+  /** \brief Leave-one-out cross validation for local kriging
+   */
+  double qual_local(double xlen, double noise_var, size_t iout,
+		    int &success) const {
+
+    double ret=0.0;
+    success=0;
+    
+    size_t m=loo_nbr[0].size();
+    ubmatrix D2(m,m), KXX(m,m);
+    ubvector w(m);
+    
+    for(size_t ell=0;ell<loo_row.size();ell++) {
+      const std::vector<size_t> &index=loo_nbr[ell];
+      for(size_t irow=0;irow<m;irow++) {
+	for(size_t icol=irow+1;icol<m;icol++) {
+	  D2(irow,icol)=local_dist2(index[irow],index[icol]);
+	}
+      }
+      double ypred;
+      if (local_solve(m,index,loo_d2[ell],D2,xlen,noise_var,iout,
+		      KXX,w,ypred)!=0) {
+	success=1;
+	return 1.0e99;
+      }
+      ret+=pow(y_local[iout][loo_row[ell]]-ypred,2.0);
+    }
+    
+    if (verbose>2) {
+      std::cout << "interpm_krige_optim::qual_local(): " << xlen << " "
+		<< ret << std::endl;
+    }
+    
+    return ret;
+  }
   
   /** \brief Function to optimize the covariance parameters
    */
@@ -443,6 +602,10 @@ namespace o2scl {
   double qual_fun(double xlen, double noise_var, size_t iout,
 		  vec3_t &y, int &success) {
 
+    if (n_local>0) {
+      return qual_local(xlen,noise_var,iout,success);
+    }
+    
     double ret=0.0;
     
     success=0;
@@ -667,6 +830,7 @@ namespace o2scl {
     mode=mode_loo_cv;
     loo_npts=100;
     len_guess_set=false;
+    n_local=0;
   }
 
   /// \name Function to minimize and various option
@@ -696,6 +860,14 @@ namespace o2scl {
 
   /// If true, use the full minimizer
   bool full_min;
+
+  /** \brief If nonzero, the number of nearest neighbors used 
+      for local kriging (default 0)
+
+      This must be set before calling set_data() or
+      set_data_noise().
+  */
+  size_t n_local;
   
   /** \brief Set the range for the length parameter
    */
@@ -772,6 +944,58 @@ namespace o2scl {
       }
     }
 
+    if (n_local>0) {
+
+      // Store the output data, since the kriging systems are
+      // solved in eval()
+      y_local.resize(n_out);
+      noise_local.resize(n_out);
+      for(size_t iout=0;iout<n_out;iout++) {
+	mat2_row_t yiout(user_y,iout);
+	y_local[iout].resize(n_points);
+	for(size_t i=0;i<n_points;i++) {
+	  y_local[iout][i]=yiout[i];
+	}
+	noise_local[iout]=noise_var[iout % noise_var.size()];
+      }
+
+      // Find the neighbors of the cross validation points. These
+      // do not depend on the length scale, so they are computed
+      // only once.
+      size_t n_loo=loo_npts;
+      if (n_loo>n_points) n_loo=n_points;
+      if (n_loo<1) n_loo=1;
+      size_t m=n_local;
+      if (m>n_points-1) m=n_points-1;
+      loo_row.resize(n_loo);
+      loo_nbr.resize(n_loo);
+      loo_d2.resize(n_loo);
+      loo_len_avg=0.0;
+      ubvector xrow(n_in);
+      for(size_t ell=0;ell<n_loo;ell++) {
+	loo_row[ell]=ell*n_points/n_loo;
+	for(size_t k=0;k<n_in;k++) {
+	  xrow[k]=(this->x)(loo_row[ell],k);
+	}
+	local_nearest(xrow,m,loo_row[ell],loo_nbr[ell],loo_d2[ell]);
+	loo_len_avg+=sqrt(loo_d2[ell][m-1])/((double)n_loo);
+      }
+
+      if (verbose>1) {
+	std::cout << "interpm_krige_optim::set_data_noise() : local "
+		  << "kriging with " << n_local << " points,\n\t"
+		  << "average neighbor distance " << loo_len_avg
+		  << std::endl;
+      }
+      
+    } else {
+      y_local.clear();
+      noise_local.clear();
+      loo_row.clear();
+      loo_nbr.clear();
+      loo_d2.clear();
+    }
+    
     int success=0;
 
     this->Kinvf.resize(n_out);
@@ -807,7 +1031,9 @@ namespace o2scl {
 	
 	double len_opt;
 	// Choose average distance for first guess
-	if (this->rescaled) {
+	if (n_local>0) {
+	  len_opt=loo_len_avg;
+	} else if (this->rescaled) {
 	  len_opt=(this->max[iout]-this->min[iout])/((double)this->np);
 	} else {
 	  len_opt=2.0/((double)this->np);
@@ -841,7 +1067,9 @@ namespace o2scl {
 	if (len_guess_set==false) {
 	  double len_avg;
 	  // Choose average distance for first guess
-	  if (this->rescaled) {
+	  if (n_local>0) {
+	    len_avg=loo_len_avg;
+	  } else if (this->rescaled) {
 	    len_avg=(this->max[iout]-this->min[iout])/((double)this->np);
 	  } else {
 	    len_avg=2.0/((double)this->np);
@@ -941,6 +1169,95 @@ namespace o2scl {
     (n_in,n_out,n_points,user_x,
      user_y,noise_vec,len_precompute,rescale,err_on_fail);
   }
+
+  /** \brief Given input vector \c x0 store the result of the
+      interpolation in \c y0
+
+      This function evaluates the covariance function directly
+      and, if \ref n_local is nonzero, uses only the nearest 
+      neighbors of \c x0.
+  */
+  template<class vec2_t, class vec3_t>
+  void eval(const vec2_t &x0, vec3_t &y0) const {
+    
+    if (this->data_set==false) {
+      O2SCL_ERR("Data not set in interpm_krige_optim::eval().",
+		exc_einval);
+    }
+
+    // If necessary, rescale before evaluating the interpolated
+    // result
+    ubvector x0p(this->nd_in);
+    for(size_t iin=0;iin<this->nd_in;iin++) {
+      if (this->rescaled) {
+	x0p[iin]=((x0[iin]-this->min[iin])/
+		  (this->max[iin]-this->min[iin])-0.5)*2.0;
+      } else {
+	x0p[iin]=x0[iin];
+      }
+    }
+
+    if (n_local==0) {
+
+      for(size_t iout=0;iout<this->nd_out;iout++) {
+	double fac=-0.5/len[iout]/len[iout];
+	double sum=0.0;
+	for(size_t ipoints=0;ipoints<this->np;ipoints++) {
+	  double d2=0.0;
+	  for(size_t k=0;k<this->nd_in;k++) {
+	    double d=(this->x)(ipoints,k)-x0p[k];
+	    d2+=d*d;
+	  }
+	  sum+=exp(d2*fac)*this->Kinvf[iout][ipoints];
+	}
+	y0[iout]=sum;
+      }
+      
+      return;
+    }
+
+    // Find the nearest neighbors and their mutual distances, which
+    // are the same for all of the output functions
+    size_t m=n_local;
+    if (m>this->np) m=this->np;
+    std::vector<size_t> index;
+    std::vector<double> d2;
+    local_nearest(x0p,m,this->np,index,d2);
+    
+    ubmatrix D2(m,m), KXX(m,m);
+    ubvector w(m);
+    for(size_t irow=0;irow<m;irow++) {
+      for(size_t icol=irow+1;icol<m;icol++) {
+	D2(irow,icol)=local_dist2(index[irow],index[icol]);
+      }
+    }
+
+    for(size_t iout=0;iout<this->nd_out;iout++) {
+      double ypred;
+      if (local_solve(m,index,d2,D2,len[iout],noise_local[iout],iout,
+		      KXX,w,ypred)!=0) {
+	O2SCL_ERR2("Matrix singular (Cholesky method) ",
+		   "in interpm_krige_optim::eval().",o2scl::exc_esing);
+      }
+      y0[iout]=ypred;
+    }
+    
+    return;
+  }
+
+  /** \brief Given input vector \c x0 store the result of the
+      interpolation in \c y0
+
+      The covariance functions in \c fcovar are ignored, since
+      the covariance function is always the one which was optimized
+      in set_data(). This version is present for compatibility with
+      \ref interpm_krige::eval() .
+  */
+  template<class vec2_t, class vec3_t, class vec_func_t>
+  void eval(const vec2_t &x0, vec3_t &y0, vec_func_t &fcovar) const {
+    eval(x0,y0);
+    return;
+  }
   
   };
 
@@ -348,6 +348,82 @@ int main(void) {
   }
   */
 
+  {
+    cout << "interpm_krige_optim, local kriging" << endl;
+
+    // Construct the data. Note that the rescaling modifies
+    // the x data in place, so each object gets its own copy.
+    rng_gsl r;
+    size_t N=200;
+    vector<ubvector> xa, xb;
+    vector<ubvector> y(1);
+    y[0].resize(N);
+    ubvector tmp(2);
+    for(size_t i=0;i<N;i++) {
+      tmp[0]=r.random();
+      tmp[1]=r.random();
+      xa.push_back(tmp);
+      y[0][i]=ft(tmp[0],tmp[1]);
+    }
+    xb=xa;
+    mat_t xa2(xa), xb2(xb), y2(y);
+    ubvector len(1), noise(1);
+    // With 200 points in the rescaled coordinates, this length
+    // scale and noise keep the condition number of the covariance
+    // matrix near 1e5
+    len[0]=0.15;
+    noise[0]=1.0e-4;
+
+    // If the number of neighbors is larger than the number of
+    // points, local kriging should agree with the full result
+    interpm_krige_optim<ubvector,mat_t,matrix_row_gen<mat_t> > iko_full;
+    iko_full.set_data_noise<matrix_row_gen<mat_t> >
+      (2,1,N,xa2,y2,noise,len,true);
+    
+    interpm_krige_optim<ubvector,mat_t,matrix_row_gen<mat_t> > iko_loc;
+    iko_loc.n_local=N+10;
+    iko_loc.set_data_noise<matrix_row_gen<mat_t> >
+      (2,1,N,xb2,y2,noise,len,true);
+
+    ubvector point(2), out(1), out2(1);
+    for(size_t k=0;k<10;k++) {
+      point[0]=0.1+0.08*k;
+      point[1]=0.9-0.07*k;
+      iko_full.eval(point,out);
+      iko_loc.eval(point,out2);
+      t.test_rel(out[0],out2[0],1.0e-6,"local vs. full");
+      iko_full.eval(point,out2,iko_full.ff2);
+      t.test_rel(out[0],out2[0],1.0e-10,"inlined vs. std::function");
+    }
+
+    // A larger data set with a small number of neighbors
+    // and the length scale chosen by cross validation
+    N=20000;
+    vector<ubvector> xc;
+    vector<ubvector> yc(1);
+    yc[0].resize(N);
+    for(size_t i=0;i<N;i++) {
+      tmp[0]=r.random();
+      tmp[1]=r.random();
+      xc.push_back(tmp);
+      yc[0][i]=ft(tmp[0],tmp[1]);
+    }
+    mat_t xc2(xc), yc2(yc);
+    
+    interpm_krige_optim<ubvector,mat_t,matrix_row_gen<mat_t> > iko_big;
+    iko_big.n_local=20;
+    ubvector len_empty;
+    iko_big.set_data<matrix_row_gen<mat_t> >(2,1,N,xc2,yc2,len_empty,
+					     true);
+    for(size_t k=0;k<10;k++) {
+      point[0]=0.1+0.08*k;
+      point[1]=0.9-0.07*k;
+      iko_big.eval(point,out);
+      t.test_rel(out[0],ft(point[0],point[1]),1.0e-4,"local, large");
+    }
+    cout << endl;
+  }
+
   t.report();
   return 0;
 }
@@ -0,0 +1,94 @@
+/*
+  -------------------------------------------------------------------
+  
+  Copyright (C) 2006-2019, Andrew W. Steiner
+  
+  This file is part of O2scl.
+  
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+  
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <o2scl/vec_stats.h>
+
+#ifdef O2SCL_FFTW
+#include <fftw3.h>
+#endif
+
+using namespace std;
+using namespace o2scl;
+
+void o2scl::vector_autocorr_fft_base(const std::vector<double> &x,
+				     size_t kmax,
+				     std::vector<double> &ac_vec) {
+
+  size_t n=x.size();
+  ac_vec.resize(kmax);
+  
+#ifdef O2SCL_FFTW
+
+  size_t len=2*n;
+  double *in=(double *)fftw_malloc(sizeof(double)*len);
+  fftw_complex *out=(fftw_complex *)fftw_malloc
+    (sizeof(fftw_complex)*(len/2+1));
+  fftw_plan p1=fftw_plan_dft_r2c_1d(len,in,out,FFTW_ESTIMATE);
+  fftw_plan p2=fftw_plan_dft_c2r_1d(len,out,in,FFTW_ESTIMATE);
+    
+  for(size_t i=0;i<n;i++) in[i]=x[i];
+  for(size_t i=n;i<len;i++) in[i]=0.0;
+  fftw_execute(p1);
+    
+  // Replace the transform with the power spectrum
+  for(size_t k=0;k<len/2+1;k++) {
+    out[k][0]=out[k][0]*out[k][0]+out[k][1]*out[k][1];
+    out[k][1]=0.0;
+  }
+  fftw_execute(p2);
+
+  for(size_t k=0;k<kmax;k++) {
+    ac_vec[k]=in[k]/in[0];
+  }
+    
+  fftw_destroy_plan(p1);
+  fftw_destroy_plan(p2);
+  fftw_free(in);
+  fftw_free(out);
+    
+#else
+
+  size_t len=2;
+  while (len<2*n) len*=2;
+    
+  std::vector<double> y(len,0.0);
+  for(size_t i=0;i<n;i++) y[i]=x[i];
+  std::vector<std::complex<double> > Y;
+  vector_fft_real_radix2(y,Y);
+    
+  // The power spectrum is real and symmetric, so its inverse
+  // transform is the real part of its forward transform
+  for(size_t k=0;k<=len/2;k++) {
+    y[k]=std::norm(Y[k]);
+    if (k>0 && k<len/2) y[len-k]=y[k];
+  }
+  vector_fft_real_radix2(y,Y);
+    
+  for(size_t k=0;k<kmax;k++) {
+    ac_vec[k]=Y[k].real()/Y[0].real();
+  }
+    
+#endif
+
+  return;
+}
+
@@ -36,6 +36,10 @@
     \future Consider generalizing to other data types.
 */
 
+#include <vector>
+#include <complex>
+#include <cmath>
+
 #include <o2scl/err_hnd.h>
 #include <o2scl/vector.h>
 
@@ -1740,7 +1744,7 @@ namespace o2scl {
 
     long double q=0.0, v=0.0;
     for(size_t i=0;i<k;i++) {
-      v+=(data[i]-mean)*(data[i]-mean)/(i+1);
+      v+=((data[i]-mean)*(data[i]-mean)-v)/(i+1);
     }
     for(size_t i=k;i<n;i++) {
       long double delta0=data[i-k]-mean;
@@ -1807,6 +1811,127 @@ namespace o2scl {
     return vector_lagk_autocorr(data.size(),data,k);
   }
 
+  /** \brief Compute the discrete Fourier transform of a complex
+      vector in place
+
+      The size of \c a must be a power of two. This is the 
+      iterative radix-2 Cooley-Tukey algorithm, used by 
+      \ref vector_autocorr_vector_fft() when FFTW is not available.
+  */
+  template<class fp_t>
+    void vector_fft_radix2(std::vector<std::complex<fp_t> > &a) {
+
+    size_t n=a.size();
+    
+    // Bit-reversal permutation
+    for(size_t i=1, j=0;i<n;i++) {
+      size_t bit=n>>1;
+      for(;j&bit;bit>>=1) j^=bit;
+      j^=bit;
+      if (i<j) std::swap(a[i],a[j]);
+    }
+
+    // Butterflies
+    for(size_t len=2;len<=n;len<<=1) {
+      fp_t ang=-2.0*acos(-1.0)/((fp_t)len);
+      std::complex<fp_t> wlen(cos(ang),sin(ang));
+      for(size_t i=0;i<n;i+=len) {
+	std::complex<fp_t> w(1.0);
+	for(size_t j=0;j<len/2;j++) {
+	  std::complex<fp_t> u=a[i+j];
+	  std::complex<fp_t> v=a[i+j+len/2]*w;
+	  a[i+j]=u+v;
+	  a[i+j+len/2]=u-v;
+	  w*=wlen;
+	}
+      }
+    }
+    
+    return;
+  }
+
+  /** \brief Compute the discrete Fourier transform of a real
+      vector
+
+      The size of \c x must be a power of two and at least 2. On
+      exit, the vector \c X holds the first <tt>x.size()/2+1</tt>
+      Fourier coefficients (the remaining coefficients are their
+      complex conjugates). The transform is computed with a complex
+      transform of half the size.
+  */
+  template<class fp_t>
+    void vector_fft_real_radix2(const std::vector<fp_t> &x,
+				std::vector<std::complex<fp_t> > &X) {
+
+    size_t n=x.size(), h=n/2;
+    
+    // Pack the even and odd elements into a complex vector
+    std::vector<std::complex<fp_t> > z(h);
+    for(size_t m=0;m<h;m++) {
+      z[m]=std::complex<fp_t>(x[2*m],x[2*m+1]);
+    }
+    vector_fft_radix2(z);
+
+    // Separate the transforms of the even and odd elements
+    X.resize(h+1);
+    fp_t ang=-2.0*acos(-1.0)/((fp_t)n);
+    for(size_t k=0;k<=h;k++) {
+      std::complex<fp_t> zk=z[k%h];
+      std::complex<fp_t> zc=std::conj(z[(h-k)%h]);
+      std::complex<fp_t> even=(zk+zc)*((fp_t)0.5);
+      std::complex<fp_t> odd=(zk-zc)*std::complex<fp_t>(0.0,-0.5);
+      X[k]=even+std::complex<fp_t>(cos(ang*k),sin(ang*k))*odd;
+    }
+    
+    return;
+  }
+  
+  /** \brief Construct an autocorrelation vector from the
+      mean-subtracted data in \c x using a fast Fourier transform
+
+      This is the function used by \ref vector_autocorr_vector_fft()
+      to perform the transforms. It is compiled into the library
+      rather than defined in this header, so the choice between FFTW
+      and the built-in radix-2 transform is made once, when \o2 is
+      installed, and not separately by each code which includes this
+      header. On exit, \c ac_vec has size \c kmax, which must be
+      at least 1 and no larger than <tt>x.size()</tt>.
+  */
+  void vector_autocorr_fft_base(const std::vector<double> &x,
+				size_t kmax, std::vector<double> &ac_vec);
+  
+  /** \brief Construct an autocorrelation vector for the first
+      \c n elements of \c data using a fast Fourier transform
+
+      This function stores in \c ac_vec the lag-k autocorrelation
+      (see \ref vector_lagk_autocorr() ) for \f$ 0 \leq k <
+      k_{\mathrm{max}} \f$ using the Wiener-Khinchin theorem. The data
+      is zero-padded to avoid the periodic wrap-around, so the
+      result agrees with the direct computation to within
+      roundoff error, but requires only \f$ {\cal O}(n \log n) \f$
+      operations. If \o2 was installed with FFTW support, FFTW is
+      used for the transforms, otherwise a built-in radix-2 transform
+      is used (see \ref vector_autocorr_fft_base() ).
+
+      If \c kmax is larger than \c n, then it is set equal to \c n.
+  */
+  template<class vec_t, class resize_vec_t>
+    void vector_autocorr_vector_fft(size_t n, const vec_t &data,
+				    double mean, size_t kmax,
+				    resize_vec_t &ac_vec) {
+
+    if (kmax>n) kmax=n;
+    ac_vec.resize(kmax);
+    if (kmax==0) return;
+    
+    std::vector<double> x(n), ac;
+    for(size_t i=0;i<n;i++) x[i]=data[i]-mean;
+    vector_autocorr_fft_base(x,kmax,ac);
+    for(size_t k=0;k<kmax;k++) ac_vec[k]=ac[k];
+
+    return;
+  }
+  
   /** \brief Construct an autocorrelation vector
 
       This constructs a vector \c ac_vec for which the kth entry
@@ -1815,16 +1940,14 @@ namespace o2scl {
       \c data vector. The vector \c ac_vec is resized to accomodate
       exactly \f$ k_{\mathrm{max}} \f$ values, from 0 to 
       \f$ k_{\mathrm{max}}-1 \f$.
+
+      This function uses \ref vector_autocorr_vector_fft() .
   */
   template<class vec_t, class resize_vec_t> void vector_autocorr_vector
     (const vec_t &data, resize_vec_t &ac_vec) {
     size_t kmax=data.size()/2;
     double mean=vector_mean(data);
-    ac_vec.resize(kmax);
-    ac_vec[0]=1.0;
-    for(size_t k=1;k<kmax;k++) {
-      ac_vec[k]=vector_lagk_autocorr(data.size(),data,k,mean);
-    }
+    vector_autocorr_vector_fft(data.size(),data,mean,kmax,ac_vec);
     return;
   }
 
@@ -1858,11 +1981,9 @@ namespace o2scl {
     five_tau_over_M.resize(0);
     size_t len=0;
     bool len_set=false;
+    double sum=0.0;
     for (size_t M=1;M<ac_vec.size();M++) {
-      double sum=0.0;
-      for(size_t s=1;s<=M;s++) {
-	sum+=ac_vec[s];
-      }
+      sum+=ac_vec[M];
       double val=(1.0+2.0*sum)/((double)M)*5.0;
       if (len_set==false && val<=1.0) {
 	len=M;
@@ -1900,7 +2021,7 @@ namespace o2scl {
     long double q=0.0, v=0.0;
     size_t im=0, ix=0, im2=0, ix2=0;
     for(size_t i=0;i<k;i++) {
-      v+=(data[ix]-mean)*(data[ix]-mean)/(i+1);
+      v+=((data[ix]-mean)*(data[ix]-mean)-v)/(i+1);
       im++;
       if (im>=((size_t)(mult[ix]*(1.0+1.0e-10)))) {
 	im=0;
@@ -1961,18 +2082,20 @@ namespace o2scl {
     void vector_autocorr_vector_mult
     (size_t n2, const vec_t &data, const vec2_t &mult, resize_vec_t &ac_vec) {
 
-    size_t n=0;
+    // Expand the data according to the multiplier 
+    std::vector<double> expanded;
     for(size_t i=0;i<n2;i++) {
-      n+=((size_t)(mult[i]*(1.0+1.0e-10)));
+      size_t m=((size_t)(mult[i]*(1.0+1.0e-10)));
+      if (m==0) {
+	O2SCL_ERR2("Mult vector is zero ",
+		   "in vector_autocorr_vector_mult().",exc_einval);
+      }
+      expanded.insert(expanded.end(),m,data[i]);
     }
     
-    size_t kmax=n/2;
-    double mean=wvector_mean(data,mult);
-    ac_vec.resize(kmax);
-    ac_vec[0]=1.0;
-    for(size_t k=1;k<kmax;k++) {
-      ac_vec[k]=vector_lagk_autocorr_mult(n2,data,mult,k,mean);
-    }
+    size_t kmax=expanded.size()/2;
+    double mean=wvector_mean(n2,data,mult);
+    vector_autocorr_vector_fft(expanded.size(),expanded,mean,kmax,ac_vec);
     return;
   }
 
@@ -189,6 +189,40 @@ int main(void) {
     size_t ac_len2=o2scl::vector_autocorr_tau(ac2,ftom2);
     t.test_gen(ac_len==ac_len2,"vector_autocorr_vector.");
     cout << ac_len << " " << ac_len2 << endl;
+    t.test_rel_vec(ac.size(),ac,ac2,1.0e-12,"vector_autocorr_vector_mult.");
+  }
+
+  if (true) {
+    cout << "------------------------------------------------------------"
+	 << endl;
+    cout << "Testing vector_autocorr_vector_fft(): " << endl;
+
+    // Compare with the direct computation for an autocorrelated
+    // sequence with a length which is not a power of two
+    std::vector<double> x0;
+    rng_gsl r;
+    double last=0.0;
+    for(size_t i=0;i<1001;i++) {
+      last=0.9*last+r.random()-0.5;
+      x0.push_back(last);
+    }
+    double mean=vector_mean(x0);
+    std::vector<double> ac, ac_direct(500);
+    o2scl::vector_autocorr_vector(x0,ac);
+    t.test_gen(ac.size()==500,"fft size");
+    ac_direct[0]=1.0;
+    for(size_t k=1;k<500;k++) {
+      ac_direct[k]=vector_lagk_autocorr(x0.size(),x0,k,mean);
+    }
+    t.test_abs_vec(500,ac,ac_direct,1.0e-12,"fft vs. direct");
+
+    // A power of two and a very short vector
+    std::vector<double> y={1.0,3.0,2.0,5.0};
+    o2scl::vector_autocorr_vector_fft(4,y,vector_mean(y),4,ac);
+    for(size_t k=1;k<4;k++) {
+      t.test_abs(ac[k],vector_lagk_autocorr(4,y,k,vector_mean(y)),
+		 1.0e-12,"fft short");
+    }
   }
   
   t.report();
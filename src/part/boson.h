@@ -96,6 +96,50 @@ namespace o2scl {
     */
     virtual void pair_density(boson &b, double temper)=0;
 
+    /// \name Batched calculations
+    //@{
+    /** \brief Calculate properties as function of chemical potential
+	for \c n points
+
+	The mass, effective mass, degeneracy and flags are taken from
+	\c b, which is not modified. The chemical potential for each
+	point is taken from <tt>mu[i]</tt>, which is the effective
+	chemical potential if <tt>b.non_interacting</tt> is false, and
+	the results are stored in the arrays \c nd, \c ed, \c pr and 
+	\c en. See \ref part_batch_mu(). 
+
+	The default implementation calls \ref calc_mu() for each 
+	point. Children override this function to avoid the
+	virtual function call for each point.
+    */
+    virtual void calc_mu_batch(const boson &b, size_t n,
+			       const double *mu, const double *T,
+			       double *nd, double *ed, double *pr,
+			       double *en) {
+      part_batch_mu(b,n,mu,T,nd,ed,pr,en,
+		    [this](boson &bt, double t) { calc_mu(bt,t); });
+      return;
+    }
+    
+    /** \brief Calculate properties as function of density
+	for \c n points (see \ref part_batch_density())
+
+	Since \ref calc_density() reports convergence failures
+	only through the error handler, this function always 
+	returns zero.
+    */
+    virtual int calc_density_batch(const boson &b, size_t n,
+				   const double *nd, const double *T,
+				   double *mu, double *ed, double *pr,
+				   double *en) {
+      return part_batch_density(b,n,nd,T,mu,ed,pr,en,
+				[this](boson &bt, double t) {
+				  calc_density(bt,t);
+				  return 0;
+				});
+    }
+    //@}
+
   };
   
 #ifndef DOXYGEN_NO_O2NS
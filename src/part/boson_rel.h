@@ -82,6 +82,33 @@ namespace o2scl {
     /// Calculate effective chemical potential from density
     virtual void nu_from_n(boson &b, double temper);
 
+    /** \brief Calculate properties as function of chemical potential
+	for \c n points (see \ref boson_thermo::calc_mu_batch())
+    */
+    virtual void calc_mu_batch(const boson &b, size_t n,
+			       const double *mu, const double *T,
+			       double *nd, double *ed, double *pr,
+			       double *en) {
+      part_batch_mu(b,n,mu,T,nd,ed,pr,en,
+		    [this](boson &bt, double t) {
+		      boson_rel::calc_mu(bt,t); });
+      return;
+    }
+    
+    /** \brief Calculate properties as function of density
+	for \c n points (see \ref boson_thermo::calc_density_batch())
+    */
+    virtual int calc_density_batch(const boson &b, size_t n,
+				   const double *nd, const double *T,
+				   double *mu, double *ed, double *pr,
+				   double *en) {
+      return part_batch_density(b,n,nd,T,mu,ed,pr,en,
+				[this](boson &bt, double t) {
+				  boson_rel::calc_density(bt,t);
+				  return 0;
+				});
+    }
+
     /// Set degenerate and nondegenerate integrators
     void set_inte(inte<> &l_nit, inte<> &l_dit);
 
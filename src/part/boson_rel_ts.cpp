@@ -176,6 +176,24 @@ int main(void) {
     rb.def_dit.tol_abs*=1.0e2;
     part_calibrate(b,rb,0,"../../data/o2scl/boson_cal.o2",false,1,1);
   */
+
+  // Test the batched function
+  {
+    boson b2(1.1,2.0);
+    b2.non_interacting=true;
+    double mu[3], Tb[3], nd[3], ed[3], pr[3], en[3];
+    for(size_t i=0;i<3;i++) {
+      mu[i]=0.8+0.1*i;
+      Tb[i]=0.1;
+    }
+    rb.calc_mu_batch(b2,3,mu,Tb,nd,ed,pr,en);
+    for(size_t i=0;i<3;i++) {
+      b2.mu=mu[i];
+      rb.calc_mu(b2,Tb[i]);
+      t.test_rel(nd[i],b2.n,1.0e-12,"calc_mu_batch n");
+      t.test_rel(en[i],b2.en,1.0e-12,"calc_mu_batch en");
+    }
+  }
   
   t.report();
   return 0;
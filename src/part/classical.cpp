@@ -132,3 +132,74 @@ void classical_thermo::calc_density(part &p, double temper) {
   return;
 }
 
+
+void classical_thermo::calc_mu_batch(const part &p, size_t n,
+				     const double *mu, const double *T,
+				     double *nd, double *ed, double *pr,
+				     double *en) {
+
+  bool all_pos=true;
+  for(size_t i=0;i<n;i++) {
+    if (!(T[i]>0.0)) all_pos=false;
+  }
+  if (!all_pos) {
+    part_batch_mu(p,n,mu,T,nd,ed,pr,en,
+		  [this](part &pt, double t) {
+		    classical_thermo::calc_mu(pt,t); });
+    return;
+  }
+  
+  double ms=p.ms;
+  if (p.non_interacting) ms=p.m;
+  double mrest=0.0;
+  if (p.inc_rest_mass) mrest=p.m;
+  double fac=p.g*pow(ms/pi/2.0,1.5);
+  
+  for(size_t i=0;i<n;i++) {
+    double t=T[i];
+    double x=(mu[i]-mrest)/t;
+    double nn=(x<-500.0) ? 0.0 : exp(x)*fac*t*sqrt(t);
+    nd[i]=nn;
+    ed[i]=1.5*t*nn+nn*mrest;
+    pr[i]=nn*t;
+    en[i]=(ed[i]+pr[i]-nn*mu[i])/t;
+  }
+
+  return;
+}
+
+int classical_thermo::calc_density_batch(const part &p, size_t n,
+					 const double *nd, const double *T,
+					 double *mu, double *ed, double *pr,
+					 double *en) {
+
+  bool all_pos=true;
+  for(size_t i=0;i<n;i++) {
+    if (!(T[i]>0.0) || !(nd[i]>0.0)) all_pos=false;
+  }
+  if (!all_pos) {
+    part_batch_density(p,n,nd,T,mu,ed,pr,en,
+		       [this](part &pt, double t) {
+			 classical_thermo::calc_density(pt,t);
+			 return 0;
+		       });
+    return 0;
+  }
+  
+  double ms=p.ms;
+  if (p.non_interacting) ms=p.m;
+  double mrest=0.0;
+  if (p.inc_rest_mass) mrest=p.m;
+  double fac=pow(2.0*pi/ms,1.5)/p.g;
+  
+  for(size_t i=0;i<n;i++) {
+    double t=T[i];
+    double nn=nd[i];
+    mu[i]=mrest+t*log(nn*fac/(t*sqrt(t)));
+    ed[i]=1.5*t*nn+nn*mrest;
+    pr[i]=nn*t;
+    en[i]=(ed[i]+pr[i]-nn*mu[i])/t;
+  }
+
+  return 0;
+}
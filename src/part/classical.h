@@ -77,6 +77,41 @@ namespace o2scl {
      */
     virtual void calc_density(part &p, double temper);
 
+    /// \name Batched calculations
+    //@{
+    /** \brief Calculate properties as function of chemical potential
+	for \c n points
+
+	The mass, effective mass, degeneracy and flags are taken from
+	\c p, which is not modified. The chemical potential for each
+	point is taken from <tt>mu[i]</tt>, which is the effective
+	chemical potential if <tt>p.non_interacting</tt> is false, and
+	the results are stored in the arrays \c nd, \c ed, \c pr and 
+	\c en. If all of the temperatures are positive, the
+	calculation is done in a single loop without branches
+	which the compiler can vectorize, otherwise \ref calc_mu()
+	is used for each point.
+    */
+    virtual void calc_mu_batch(const part &p, size_t n, const double *mu,
+			       const double *T, double *nd, double *ed,
+			       double *pr, double *en);
+
+    /** \brief Calculate properties as function of density
+	for \c n points
+
+	The chemical potentials are stored in \c mu, which is the
+	effective chemical potential if <tt>p.non_interacting</tt> is
+	false. If all of the densities and temperatures are positive,
+	the calculation is done in a single loop without branches,
+	otherwise \ref calc_density() is used for each point.
+	This function always returns zero.
+    */
+    virtual int calc_density_batch(const part &p, size_t n,
+				   const double *nd, const double *T,
+				   double *mu, double *ed, double *pr,
+				   double *en);
+    //@}
+
     /// Return string denoting type ("classical_thermo")
     virtual const char *type() { return "classical_thermo"; }
     
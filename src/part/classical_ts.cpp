@@ -47,6 +47,30 @@ int main(void) {
   cl.calc_mu(n,temper);
   t.test_rel(n.n,0.1,1.0e-8,"calc_mu(calc_density)");
 
+  // Test the batched functions
+  {
+    double mu[4], Tb[4], nd[4], ed[4], pr[4], en[4], mu2[4];
+    for(size_t i=0;i<4;i++) {
+      mu[i]=4.5+0.2*i;
+      Tb[i]=0.05+0.1*i;
+    }
+    cl.calc_mu_batch(n,4,mu,Tb,nd,ed,pr,en);
+    for(size_t i=0;i<4;i++) {
+      part n2=n;
+      n2.mu=mu[i];
+      cl.calc_mu(n2,Tb[i]);
+      t.test_rel(nd[i],n2.n,1.0e-12,"calc_mu_batch n");
+      t.test_rel(ed[i],n2.ed,1.0e-12,"calc_mu_batch ed");
+      t.test_rel(pr[i],n2.pr,1.0e-12,"calc_mu_batch pr");
+      t.test_rel(en[i],n2.en,1.0e-12,"calc_mu_batch en");
+    }
+    int ret=cl.calc_density_batch(n,4,nd,Tb,mu2,ed,pr,en);
+    t.test_gen(ret==0,"calc_density_batch ret");
+    for(size_t i=0;i<4;i++) {
+      t.test_rel(mu2[i],mu[i],1.0e-12,"calc_density_batch");
+    }
+  }
+
   t.report();
   return 0;
 }
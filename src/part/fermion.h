@@ -319,6 +319,49 @@ namespace o2scl {
     */
     virtual int pair_density(fermion &f, double temper)=0;
 
+    /// \name Batched calculations
+    //@{
+    /** \brief Calculate properties as function of chemical potential
+	for \c n points
+
+	The mass, effective mass, degeneracy and flags are taken from
+	\c f, which is not modified. The chemical potential for each
+	point is taken from <tt>mu[i]</tt>, which is the effective
+	chemical potential if <tt>f.non_interacting</tt> is false, and
+	the results are stored in the arrays \c nd, \c ed, \c pr and 
+	\c en. See \ref part_batch_mu(). 
+
+	The default implementation calls \ref calc_mu() for each 
+	point. Children override this function to avoid the
+	virtual function call for each point.
+    */
+    virtual void calc_mu_batch(const fermion &f, size_t n,
+			       const double *mu, const double *T,
+			       double *nd, double *ed, double *pr,
+			       double *en) {
+      part_batch_mu(f,n,mu,T,nd,ed,pr,en,
+		    [this](fermion &ft, double t) { calc_mu(ft,t); });
+      return;
+    }
+    
+    /** \brief Calculate properties as function of density
+	for \c n points
+
+	The result for each point is used as the initial guess for
+	the chemical potential at the next point, so this function
+	works best when the points are ordered. See \ref
+	part_batch_density().
+    */
+    virtual int calc_density_batch(const fermion &f, size_t n,
+				   const double *nd, const double *T,
+				   double *mu, double *ed, double *pr,
+				   double *en) {
+      return part_batch_density(f,n,nd,T,mu,ed,pr,en,
+				[this](fermion &ft, double t) {
+				  return calc_density(ft,t); });
+    }
+    //@}
+
     /// \name Massless fermions
     //@{
     /// Finite temperature massless fermions
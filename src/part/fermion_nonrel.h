@@ -127,6 +127,31 @@ namespace o2scl {
     /// Calculate effective chemical potential from density
     virtual void nu_from_n(fermion &f, double temper);
 
+    /** \brief Calculate properties as function of chemical potential
+	for \c n points (see \ref fermion_thermo::calc_mu_batch())
+    */
+    virtual void calc_mu_batch(const fermion &f, size_t n,
+			       const double *mu, const double *T,
+			       double *nd, double *ed, double *pr,
+			       double *en) {
+      part_batch_mu(f,n,mu,T,nd,ed,pr,en,
+		    [this](fermion &ft, double t) {
+		      fermion_nonrel::calc_mu(ft,t); });
+      return;
+    }
+    
+    /** \brief Calculate properties as function of density
+	for \c n points (see \ref fermion_thermo::calc_density_batch())
+    */
+    virtual int calc_density_batch(const fermion &f, size_t n,
+				   const double *nd, const double *T,
+				   double *mu, double *ed, double *pr,
+				   double *en) {
+      return part_batch_density(f,n,nd,T,mu,ed,pr,en,
+				[this](fermion &ft, double t) {
+				  return fermion_nonrel::calc_density(ft,t); });
+    }
+
     /** \brief Set the solver for use in calculating the chemical
 	potential from the density 
     */
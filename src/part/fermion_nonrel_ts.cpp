@@ -45,6 +45,29 @@ int main(void) {
     (f,fnr,false,"../../data/o2scl/fermion_nr_cal.o2",true,1,true);
   t.test_abs(v1,0.0,1.0e-12,"calibrate");
 
+  // Test the batched functions
+  {
+    fermion f2(1.0,2.0);
+    f2.inc_rest_mass=false;
+    double mu[4], Tb[4], nd[4], ed[4], pr[4], en[4], mu2[4];
+    for(size_t i=0;i<4;i++) {
+      mu[i]=-0.1+0.1*i;
+      Tb[i]=0.1;
+    }
+    fnr.calc_mu_batch(f2,4,mu,Tb,nd,ed,pr,en);
+    for(size_t i=0;i<4;i++) {
+      f2.mu=mu[i];
+      fnr.calc_mu(f2,Tb[i]);
+      t.test_rel(nd[i],f2.n,1.0e-12,"calc_mu_batch n");
+      t.test_rel(pr[i],f2.pr,1.0e-12,"calc_mu_batch pr");
+    }
+    int ret=fnr.calc_density_batch(f2,4,nd,Tb,mu2,ed,pr,en);
+    t.test_gen(ret==0,"calc_density_batch ret");
+    for(size_t i=0;i<4;i++) {
+      t.test_rel(mu2[i],mu[i],1.0e-6,"calc_density_batch");
+    }
+  }
+
   t.set_output_level(2);
   t.report();
 
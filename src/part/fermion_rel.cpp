@@ -49,11 +49,62 @@ fermion_rel::fermion_rel() : nit(new inte_qagiu_gsl<>),
   density_root->tol_rel=4.0e-7;
   verbose=0;
   last_method=0;
+
+  use_table=false;
+  table_tol=1.0e-7;
+  table_order=10;
+  table_max_level=3;
+  tab_order=0;
+  tab_n_psi=0;
+  tab_n_lbeta=0;
 }
 
 fermion_rel::~fermion_rel() {
 }
 
+void fermion_rel::copy_settings(const fermion_rel &src) {
+  
+  err_nonconv=src.err_nonconv;
+  min_psi=src.min_psi;
+  deg_limit=src.deg_limit;
+  exp_limit=src.exp_limit;
+  upper_limit_fac=src.upper_limit_fac;
+  deg_entropy_fac=src.deg_entropy_fac;
+  verbose=src.verbose;
+  use_expansions=src.use_expansions;
+
+  nit->tol_rel=src.nit->tol_rel;
+  nit->tol_abs=src.nit->tol_abs;
+  nit->verbose=src.nit->verbose;
+  nit->err_nonconv=src.nit->err_nonconv;
+  dit->tol_rel=src.dit->tol_rel;
+  dit->tol_abs=src.dit->tol_abs;
+  dit->verbose=src.dit->verbose;
+  dit->err_nonconv=src.dit->err_nonconv;
+  density_root->tol_rel=src.density_root->tol_rel;
+  density_root->tol_abs=src.density_root->tol_abs;
+  density_root->verbose=src.density_root->verbose;
+  density_root->ntrial=src.density_root->ntrial;
+  density_root->err_nonconv=src.density_root->err_nonconv;
+
+  use_table=src.use_table;
+  table_tol=src.table_tol;
+  table_order=src.table_order;
+  table_max_level=src.table_max_level;
+  tab_psi_min=src.tab_psi_min;
+  tab_dpsi=src.tab_dpsi;
+  tab_lbeta_min=src.tab_lbeta_min;
+  tab_dlbeta=src.tab_dlbeta;
+  tab_n_psi=src.tab_n_psi;
+  tab_n_lbeta=src.tab_n_lbeta;
+  tab_order=src.tab_order;
+  tab_cell_level=src.tab_cell_level;
+  tab_cell_start=src.tab_cell_start;
+  tab_coeffs=src.tab_coeffs;
+
+  return;
+}
+
 void fermion_rel::calc_mu(fermion &f, double temper) {
   calc_mu_tlate<fermion>(f,temper);
   return;
@@ -352,8 +403,13 @@ double fermion_rel::pair_fun(double x, fermion &f, double T, bool log_mode) {
 
   bool particles_done=false;
 
+  // Use the tabulated approximation if possible
+  if (use_table && table_density(f,T,nden_p)) {
+    particles_done=true;
+  }
+
   // Try the non-degenerate expansion if psi is small enough
-  if (use_expansions && psi<min_psi) {
+  if (use_expansions && particles_done==false && psi<min_psi) {
     if (calc_mu_ndeg(f,T,1.0e-8) && std::isfinite(f.n)) {
       particles_done=true;
       nden_p=f.n;
@@ -444,6 +500,11 @@ double fermion_rel::pair_fun(double x, fermion &f, double T, bool log_mode) {
 
   bool antiparticles_done=false;
 
+  // Use the tabulated approximation if possible
+  if (use_table && table_density(f,T,nden_ap)) {
+    antiparticles_done=true;
+  }
+
   // Evaluate the degeneracy parameter
   deg=true;
   if (f.inc_rest_mass) {
@@ -454,7 +515,7 @@ double fermion_rel::pair_fun(double x, fermion &f, double T, bool log_mode) {
   if (psi<deg_limit) deg=false;
 
   // Try the non-degenerate expansion if psi is small enough
-  if (use_expansions && psi<min_psi) {
+  if (use_expansions && antiparticles_done==false && psi<min_psi) {
     if (calc_mu_ndeg(f,T,1.0e-8)) {
       antiparticles_done=true;
       nden_ap=f.n;
@@ -547,3 +608,339 @@ double fermion_rel::pair_fun(double x, fermion &f, double T, bool log_mode) {
   return y2;
 }
 
+void fermion_rel::clear_table() {
+  tab_cell_level.clear();
+  tab_cell_start.clear();
+  tab_coeffs.clear();
+  tab_n_psi=0;
+  tab_n_lbeta=0;
+  tab_order=0;
+  return;
+}
+
+void fermion_rel::table_exact(double psi, double beta, double *lv) {
+
+  // A particle with unit mass and degeneracy, so that the results
+  // are the scaled quantities
+  fermion ft(1.0,1.0);
+  ft.inc_rest_mass=true;
+  ft.non_interacting=true;
+  ft.mu=1.0+psi*beta;
+
+  bool ut=use_table;
+  use_table=false;
+  calc_mu_tlate<fermion>(ft,beta);
+  use_table=ut;
+
+  lv[0]=log(ft.n);
+  lv[1]=log(ft.ed);
+  lv[2]=log(ft.pr);
+  lv[3]=log(ft.en);
+  
+  return;
+}
+
+void fermion_rel::table_fit(double psi0, double psi1, double lb0,
+			    double lb1, double *coeff) {
+
+  size_t np=tab_order;
+  
+  // Function values at the Chebyshev nodes, stored as 
+  // fv[(q*np+k)*np+l] for node k in psi and node l in ln(beta)
+  std::vector<double> fv(4*np*np), tmp(4*np*np), node(np);
+  for(size_t k=0;k<np;k++) {
+    node[k]=cos(pi*(k+0.5)/np);
+  }
+  for(size_t k=0;k<np;k++) {
+    double psi=(psi0+psi1)/2.0+(psi1-psi0)/2.0*node[k];
+    for(size_t l=0;l<np;l++) {
+      double lb=(lb0+lb1)/2.0+(lb1-lb0)/2.0*node[l];
+      double lv[4];
+      table_exact(psi,exp(lb),lv);
+      for(size_t q=0;q<4;q++) fv[(q*np+k)*np+l]=lv[q];
+    }
+  }
+
+  // Transform along ln(beta) and then along psi
+  for(size_t q=0;q<4;q++) {
+    for(size_t k=0;k<np;k++) {
+      for(size_t j=0;j<np;j++) {
+	double sum=0.0;
+	for(size_t l=0;l<np;l++) {
+	  sum+=fv[(q*np+k)*np+l]*cos(pi*j*(l+0.5)/np);
+	}
+	tmp[(q*np+k)*np+j]=sum*2.0/np;
+      }
+    }
+    for(size_t i=0;i<np;i++) {
+      for(size_t j=0;j<np;j++) {
+	double sum=0.0;
+	for(size_t k=0;k<np;k++) {
+	  sum+=tmp[(q*np+k)*np+j]*cos(pi*i*(k+0.5)/np);
+	}
+	sum*=2.0/np;
+	if (i==0) sum/=2.0;
+	if (j==0) sum/=2.0;
+	coeff[(q*np+i)*np+j]=sum;
+      }
+    }
+  }
+  
+  return;
+}
+
+void fermion_rel::table_series(const double *coeff, double u, double v,
+			       size_t qlo, size_t qhi, double *lv) const {
+
+  size_t np=tab_order;
+  
+  for(size_t q=qlo;q<qhi;q++) {
+    
+    // Clenshaw recurrence in u, where each coefficient is itself
+    // computed with the Clenshaw recurrence in v
+    double b1=0.0, b2=0.0;
+    for(size_t ii=np;ii>0;ii--) {
+      const double *row=coeff+(q*np+ii-1)*np;
+      double c1=0.0, c2=0.0;
+      for(size_t jj=np-1;jj>0;jj--) {
+	double c0=row[jj]+2.0*v*c1-c2;
+	c2=c1;
+	c1=c0;
+      }
+      double ci=row[0]+v*c1-c2;
+      if (ii==1) {
+	lv[q]=ci+u*b1-b2;
+      } else {
+	double b0=ci+2.0*u*b1-b2;
+	b2=b1;
+	b1=b0;
+      }
+    }
+  }
+  
+  return;
+}
+
+double fermion_rel::build_table(double psi_min, double psi_max,
+				double beta_min, double beta_max) {
+
+  if (psi_max<=psi_min || beta_min<=0.0 || beta_max<=beta_min) {
+    O2SCL_ERR2("Invalid table limits in ",
+	       "fermion_rel::build_table().",exc_einval);
+  }
+  if (table_order<2) {
+    O2SCL_ERR2("Table order less than 2 in ",
+	       "fermion_rel::build_table().",exc_einval);
+  }
+
+  clear_table();
+  
+  tab_order=table_order;
+  size_t np=tab_order;
+  size_t ncoeff=4*np*np;
+  
+  tab_psi_min=psi_min;
+  tab_n_psi=((size_t)ceil((psi_max-psi_min)/2.0-1.0e-10));
+  tab_dpsi=(psi_max-psi_min)/tab_n_psi;
+
+  tab_lbeta_min=log(beta_min);
+  tab_n_lbeta=((size_t)ceil(log10(beta_max/beta_min)-1.0e-10));
+  tab_dlbeta=log(beta_max/beta_min)/tab_n_lbeta;
+
+  size_t ncells=tab_n_psi*tab_n_lbeta;
+  std::vector<int> level(ncells);
+  std::vector<size_t> start(ncells);
+  
+  // Fractions of the subcell width for the test points, chosen to
+  // be away from the Chebyshev nodes
+  const double tfrac[3]={0.17,0.5,0.83};
+  
+  double max_dev=0.0;
+  size_t n_fail=0;
+  
+  for(size_t ic=0;ic<ncells;ic++) {
+
+    size_t ip=ic/tab_n_lbeta, ib=ic%tab_n_lbeta;
+    double psi0=tab_psi_min+ip*tab_dpsi;
+    double lb0=tab_lbeta_min+ib*tab_dlbeta;
+
+    std::vector<double> cc;
+    double cell_dev=0.0;
+    bool done=false;
+    
+    for(size_t lev=0;lev<=table_max_level && !done;lev++) {
+      
+      size_t nsub=((size_t)1) << lev;
+      double dp=tab_dpsi/nsub, db=tab_dlbeta/nsub;
+      cc.resize(nsub*nsub*ncoeff);
+      cell_dev=0.0;
+      
+      for(size_t js=0;js<nsub*nsub;js++) {
+	size_t jp=js/nsub, jb=js%nsub;
+	double p0=psi0+jp*dp, b0=lb0+jb*db;
+	table_fit(p0,p0+dp,b0,b0+db,&cc[js*ncoeff]);
+
+	// Compare with the integrated results at the test points
+	for(size_t k=0;k<3;k++) {
+	  for(size_t l=0;l<3;l++) {
+	    double lv[4], lva[4];
+	    table_exact(p0+tfrac[k]*dp,exp(b0+tfrac[l]*db),lv);
+	    table_series(&cc[js*ncoeff],2.0*tfrac[k]-1.0,
+			 2.0*tfrac[l]-1.0,0,4,lva);
+	    for(size_t q=0;q<4;q++) {
+	      double dev=fabs(exp(lva[q]-lv[q])-1.0);
+	      if (!std::isfinite(dev)) dev=1.0;
+	      if (dev>cell_dev) cell_dev=dev;
+	    }
+	  }
+	}
+      }
+      
+      if (cell_dev<table_tol) {
+	done=true;
+	level[ic]=lev;
+	start[ic]=tab_coeffs.size()/ncoeff;
+	tab_coeffs.insert(tab_coeffs.end(),cc.begin(),cc.end());
+	if (cell_dev>max_dev) max_dev=cell_dev;
+      }
+    }
+
+    if (!done) {
+      level[ic]=-1;
+      start[ic]=0;
+      n_fail++;
+    }
+
+    if (verbose>1) {
+      std::cout << "fermion_rel::build_table(): cell " << ic+1 << "/"
+		<< ncells << " level " << level[ic] << " deviation "
+		<< cell_dev << std::endl;
+    }
+  }
+
+  tab_cell_level=level;
+  tab_cell_start=start;
+  
+  if (verbose>0) {
+    std::cout << "fermion_rel::build_table(): " << ncells-n_fail
+	      << " of " << ncells << " cells within tolerance, "
+	      << "maximum deviation " << max_dev << "." << std::endl;
+  }
+  
+  return max_dev;
+}
+
+const double *fermion_rel::table_locate(double psi, double lbeta,
+					double &u, double &v) const {
+
+  double xp=(psi-tab_psi_min)/tab_dpsi;
+  double xb=(lbeta-tab_lbeta_min)/tab_dlbeta;
+  if (!(xp>=0.0 && xp<=tab_n_psi && xb>=0.0 && xb<=tab_n_lbeta)) {
+    return 0;
+  }
+  
+  size_t ip=(size_t)xp, ib=(size_t)xb;
+  if (ip>=tab_n_psi) ip=tab_n_psi-1;
+  if (ib>=tab_n_lbeta) ib=tab_n_lbeta-1;
+  size_t ic=ip*tab_n_lbeta+ib;
+  int lev=tab_cell_level[ic];
+  if (lev<0) return 0;
+  
+  size_t nsub=((size_t)1) << lev;
+  double sp=(xp-ip)*nsub, sb=(xb-ib)*nsub;
+  size_t jp=(size_t)sp, jb=(size_t)sb;
+  if (jp>=nsub) jp=nsub-1;
+  if (jb>=nsub) jb=nsub-1;
+  u=2.0*(sp-jp)-1.0;
+  v=2.0*(sb-jb)-1.0;
+  
+  return &tab_coeffs[(tab_cell_start[ic]+jp*nsub+jb)*4*tab_order*tab_order];
+}
+
+bool fermion_rel::table_eval(double psi, double beta, double &n,
+			     double &ed, double &pr, double &en) const {
+  
+  if (!table_built() || !(beta>0.0)) return false;
+  double u, v;
+  const double *coeff=table_locate(psi,log(beta),u,v);
+  if (coeff==0) return false;
+  
+  double lv[4];
+  table_series(coeff,u,v,0,4,lv);
+  n=exp(lv[0]);
+  ed=exp(lv[1]);
+  pr=exp(lv[2]);
+  en=exp(lv[3]);
+  
+  return true;
+}
+
+bool fermion_rel::table_density(fermion &f, double temper, double &n) {
+  
+  if (!table_built() || f.ms<=0.0) return false;
+  
+  double nu_t=f.nu;
+  if (!f.inc_rest_mass) nu_t+=f.m;
+  double u, v;
+  const double *coeff=table_locate((nu_t-f.ms)/temper,
+				   log(temper/f.ms),u,v);
+  if (coeff==0) return false;
+
+  double lv[1];
+  table_series(coeff,u,v,0,1,lv);
+  n=exp(lv[0])*f.g*f.ms*f.ms*f.ms;
+  
+  return true;
+}
+
+bool fermion_rel::table_solve_psi(double n_scaled, double beta,
+				  double &psi) const {
+  
+  if (!table_built() || !(beta>0.0) || !(n_scaled>0.0)) return false;
+
+  double lbeta=log(beta), target=log(n_scaled);
+  double u, v, lv[1];
+
+  // The logarithm of the density as a function of psi at fixed
+  // beta, returning false outside the table
+  auto lnf=[&](double x, double &y) -> bool {
+    const double *coeff=table_locate(x,lbeta,u,v);
+    if (coeff==0) return false;
+    table_series(coeff,u,v,0,1,lv);
+    y=lv[0]-target;
+    return true;
+  };
+
+  // Bracket the solution with the table limits
+  double a=tab_psi_min, b=tab_psi_min+tab_n_psi*tab_dpsi, fa, fb;
+  if (!lnf(a,fa) || !lnf(b,fb)) return false;
+  if (fa>0.0 || fb<0.0) return false;
+
+  // Illinois variant of the false position method, which converges
+  // quickly because the logarithm of the density is nearly linear
+  int side=0;
+  for(size_t it=0;it<200;it++) {
+    double c=(a*fb-b*fa)/(fb-fa);
+    if (!(c>a && c<b)) c=(a+b)/2.0;
+    double fc;
+    if (!lnf(c,fc)) return false;
+    if (fabs(fc)<1.0e-15 || (b-a)<1.0e-14*(1.0+fabs(c))) {
+      psi=c;
+      return true;
+    }
+    if (fc<0.0) {
+      a=c;
+      fa=fc;
+      if (side==-1) fb/=2.0;
+      side=-1;
+    } else {
+      b=c;
+      fb=fc;
+      if (side==1) fa/=2.0;
+      side=1;
+    }
+  }
+  
+  psi=(a+b)/2.0;
+  return true;
+}
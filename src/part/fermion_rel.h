@@ -255,9 +255,104 @@ namespace o2scl {
     /// If true, use expansions for extreme conditions (default true)
     bool use_expansions;
 
+    /// \name Tabulated approximation
+    //@{
+    /** \brief If true, use the tabulated approximation whenever
+	possible (default false)
+
+	If this is true and \ref build_table() has been called, then
+	\ref calc_mu_tlate() and \ref calc_density_tlate() use the
+	tabulated approximation in place of the integrators and the
+	density solver, and \ref pair_fun() uses it for the particle
+	and antiparticle densities. Points outside the tabulated region
+	(or in cells where the requested accuracy could not be
+	reached) are handled with the usual expansions and
+	integrators.
+    */
+    bool use_table;
+
+    /** \brief Relative tolerance for the tabulated approximation 
+	(default \f$ 10^{-7} \f$)
+    */
+    double table_tol;
+
+    /** \brief Number of Chebyshev polynomials in each direction
+	in each cell (default 10)
+    */
+    size_t table_order;
+
+    /** \brief The maximum number of times each cell is halved
+	in order to reach \ref table_tol (default 3)
+    */
+    size_t table_max_level;
+
+    /** \brief Construct the tabulated approximation for the 
+	specified range of degeneracy parameter, \f$ \psi \f$, and 
+	ratio of temperature to effective mass, \f$ \beta \f$
+
+	The degeneracy parameter is \f$ \psi=(\nu-m^{*})/T \f$ 
+	(including the rest mass in \f$ \nu \f$), and \f$ \beta
+	= T/m^{*} \f$. For fixed \f$ \psi \f$ and \f$ \beta \f$, 
+	the density and entropy density scale with \f$ g m^{*3} \f$
+	and the energy density and pressure scale with \f$ g m^{*4}
+	\f$, so the logarithms of the four scaled quantities are
+	approximated by two-dimensional Chebyshev series in 
+	\f$ \psi \f$ and \f$ \ln \beta \f$. The region is divided 
+	into cells of width about 2 in \f$ \psi \f$ and a factor 
+	of 10 in \f$ \beta \f$, and each cell is repeatedly halved 
+	(up to \ref table_max_level times) until the approximation 
+	matches the integrated results to within \ref table_tol at 
+	a set of test points in the interior of each subcell. Cells 
+	which cannot reach this tolerance are not used.
+
+	The approximation is computed using the current settings of
+	the integrators, which must be at least as accurate as \ref
+	table_tol. The return value is the largest relative
+	deviation found at the test points in the cells that are
+	used.
+    */
+    double build_table(double psi_min=-4.0, double psi_max=20.0,
+		       double beta_min=1.0e-3, double beta_max=1.0e3);
+
+    /// Return true if the tabulated approximation has been built
+    bool table_built() const {
+      return tab_cell_level.size()>0;
+    }
+
+    /// Free the memory used by the tabulated approximation
+    void clear_table();
+
+    /** \brief Evaluate the tabulated approximation
+
+	This computes the scaled density, energy density (including
+	the rest mass), pressure, and entropy density, i.e. the 
+	values for a particle with \f$ m^{*}=1 \f$ and \f$ g=1 \f$, 
+	at the specified values of \f$ \psi \f$ and \f$ \beta \f$. 
+	It returns false if the point is not covered by the table.
+    */
+    bool table_eval(double psi, double beta, double &n, double &ed,
+		    double &pr, double &en) const;
+    //@}
+
     /// Create a fermion with mass \c m and degeneracy \c g
     fermion_rel();
 
+    /** \brief Copy the numerical settings and the tabulated 
+	approximation from \c src
+
+	This copies the numerical parameters, the settings for the
+	tabulated approximation and the table itself, and the 
+	tolerances, iteration limits, verbosity and convergence error
+	settings of \ref nit, \ref dit and \ref density_root. The 
+	integration and solver objects are not shared with \c src, so
+	the two objects can be used in different threads. If the
+	integrators or the solver of \c src have been replaced by
+	objects of a different type, only these common settings are
+	copied and the types of the integrators and the solver of
+	this object are unchanged.
+    */
+    void copy_settings(const fermion_rel &src);
+
     virtual ~fermion_rel();
 
     /** \brief Calculate properties as function of chemical potential
@@ -286,6 +381,31 @@ namespace o2scl {
     /** \brief Calculate effective chemical potential from density
      */
     virtual int nu_from_n(fermion &f, double temper);
+
+    /** \brief Calculate properties as function of chemical potential
+	for \c n points (see \ref fermion_thermo::calc_mu_batch())
+    */
+    virtual void calc_mu_batch(const fermion &f, size_t n,
+			       const double *mu, const double *T,
+			       double *nd, double *ed, double *pr,
+			       double *en) {
+      part_batch_mu(f,n,mu,T,nd,ed,pr,en,
+		    [this](fermion &ft, double t) {
+		      calc_mu_tlate<fermion>(ft,t); });
+      return;
+    }
+    
+    /** \brief Calculate properties as function of density
+	for \c n points (see \ref fermion_thermo::calc_density_batch())
+    */
+    virtual int calc_density_batch(const fermion &f, size_t n,
+				   const double *nd, const double *T,
+				   double *mu, double *ed, double *pr,
+				   double *en) {
+      return part_batch_density(f,n,nd,T,mu,ed,pr,en,
+				[this](fermion &ft, double t) {
+				  return calc_density_tlate<fermion>(ft,t); });
+    }
     
     /// The non-degenerate integrator
     std::shared_ptr<inte<> > nit;
@@ -318,6 +438,7 @@ namespace o2scl {
 	- 8: exact integration, degenerate integrands, full
 	entropy integration
 	- 9: T=0 result
+	- 10: tabulated approximation
 
 	In \ref calc_density_tlate(), the integer is a two-digit
 	number. The first digit (1 to 3) is the method used by \ref
@@ -330,7 +451,8 @@ namespace o2scl {
 	- 5: exact integration, degenerate integrands, full
 	entropy integration
 	If \ref calc_density_tlate() uses the T=0 code, then
-	last_method is 40. 
+	last_method is 40, and if it uses the tabulated 
+	approximation then last_method is 50.
 
 	In \ref pair_mu_tlate(), the integer is a three-digit number.
 	The third digit is always 0 (to ensure a value of last_method
@@ -537,6 +659,12 @@ namespace o2scl {
 	psi=(f.nu+(f.m-f.ms))/temper;
       }
       if (psi<deg_limit) deg=false;
+
+      // Use the tabulated approximation if possible
+      if (use_table && table_calc_mu(f,temper)) {
+	last_method=10;
+	return;
+      }
   
       // Try the non-degenerate expansion if psi is small enough
       if (use_expansions && psi<min_psi) {
@@ -743,6 +871,15 @@ namespace o2scl {
       // First determine the chemical potential by solving for the density
 
       if (f.non_interacting==true) { f.nu=f.mu; f.ms=f.m; }
+
+      // Use the tabulated approximation if possible
+      if (use_table && table_nu_from_n(f,temper) &&
+	  table_calc_mu(f,temper)) {
+	if (f.non_interacting) { f.mu=f.nu; }
+	f.n=density_temp;
+	last_method=50;
+	return 0;
+      }
   
       int ret=nu_from_n(f,temper);
       last_method*=10;
@@ -1120,6 +1257,119 @@ namespace o2scl {
 	antiparticles.
     */
     double pair_fun(double x, fermion &f, double T, bool log_mode);
+
+    /// \name Tabulated approximation
+    //@{
+    /// Lower limit of \f$ \psi \f$ in the table
+    double tab_psi_min;
+    /// Width of the base cells in \f$ \psi \f$
+    double tab_dpsi;
+    /// Lower limit of \f$ \ln \beta \f$ in the table
+    double tab_lbeta_min;
+    /// Width of the base cells in \f$ \ln \beta \f$
+    double tab_dlbeta;
+    /// Number of base cells in \f$ \psi \f$
+    size_t tab_n_psi;
+    /// Number of base cells in \f$ \ln \beta \f$
+    size_t tab_n_lbeta;
+    /// Number of Chebyshev polynomials in each direction
+    size_t tab_order;
+    /** \brief The number of times each base cell is halved, or
+	-1 if the cell could not be fit
+    */
+    std::vector<int> tab_cell_level;
+    /// The index of the first subcell for each base cell
+    std::vector<size_t> tab_cell_start;
+    /** \brief The Chebyshev coefficients, \f$ 4 N^2 \f$ 
+	numbers for each subcell
+    */
+    std::vector<double> tab_coeffs;
+
+    /** \brief Compute the logarithms of the scaled density, energy 
+	density, pressure and entropy using the integrators
+    */
+    void table_exact(double psi, double beta, double *lv);
+
+    /** \brief Compute the Chebyshev coefficients for the rectangle
+	\f$ [\psi_0,\psi_1] \times [\ln \beta_0,\ln \beta_1] \f$
+    */
+    void table_fit(double psi0, double psi1, double lb0, double lb1,
+		   double *coeff);
+
+    /** \brief Find the coefficients and the scaled coordinates 
+	for the subcell containing the specified point
+    */
+    const double *table_locate(double psi, double lbeta, double &u,
+			       double &v) const;
+
+    /** \brief Evaluate the Chebyshev series for quantities 
+	\c qlo to <tt>qhi-1</tt> and store the logarithms in \c lv
+    */
+    void table_series(const double *coeff, double u, double v,
+		      size_t qlo, size_t qhi, double *lv) const;
+
+    /** \brief Compute the thermodynamic quantities from the tabulated 
+	approximation, returning false if the point is not covered
+    */
+    template<class fermion_t>
+      bool table_calc_mu(fermion_t &f, double temper) {
+      
+      if (!table_built() || f.ms<=0.0) return false;
+      
+      double nu_t=f.nu;
+      if (!f.inc_rest_mass) nu_t+=f.m;
+      double beta=temper/f.ms;
+      double n, ed, pr, en;
+      if (!table_eval((nu_t-f.ms)/temper,beta,n,ed,pr,en)) return false;
+
+      double m3=f.g*f.ms*f.ms*f.ms;
+      f.n=n*m3;
+      f.ed=ed*m3*f.ms;
+      f.pr=pr*m3*f.ms;
+      f.en=en*m3;
+      if (!f.inc_rest_mass) f.ed-=f.n*f.m;
+      
+      unc.n=f.n*table_tol;
+      unc.ed=fabs(f.ed)*table_tol;
+      unc.pr=f.pr*table_tol;
+      unc.en=f.en*table_tol;
+      
+      return true;
+    }
+
+    /** \brief Compute the density from the tabulated approximation,
+	returning false if the point is not covered
+    */
+    bool table_density(fermion &f, double temper, double &n);
+
+    /** \brief Solve for the effective chemical potential using
+	the tabulated approximation, returning false if the density 
+	is not covered by the table
+
+	If this function returns false, <tt>f.nu</tt> is unchanged.
+    */
+    template<class fermion_t>
+      bool table_nu_from_n(fermion_t &f, double temper) {
+      
+      if (!table_built() || f.ms<=0.0 || f.n<=0.0) return false;
+
+      double nu;
+      if (!table_solve_psi(f.n/(f.g*f.ms*f.ms*f.ms),temper/f.ms,nu)) {
+	return false;
+      }
+      nu=f.ms+nu*temper;
+      if (!f.inc_rest_mass) nu-=f.m;
+      f.nu=nu;
+      
+      return true;
+    }
+
+    /** \brief Solve for the value of \f$ \psi \f$ which gives the
+	scaled density \c n_scaled at the specified value of 
+	\f$ \beta \f$
+    */
+    bool table_solve_psi(double n_scaled, double beta, double &psi) const;
+    //@}
     
 #endif
 
@@ -68,6 +68,97 @@ int main(void) {
     (f,fr,1,"../../data/o2scl/fermion_deriv_cal.o2",false,1,1);
   t.test_rel(v2,0.0,4.0e-10,"calibrate 2");
 
+  // -----------------------------------------------------------------
+  // Test the batched functions
+
+  {
+    fermion_rel fr2;
+    fermion f2(1.0,2.0);
+    double mu[5], Tb[5], nd[5], ed[5], pr[5], en[5], mu2[5];
+    for(size_t i=0;i<5;i++) {
+      mu[i]=0.9+0.1*i;
+      Tb[i]=0.1;
+    }
+    fr2.calc_mu_batch(f2,5,mu,Tb,nd,ed,pr,en);
+    for(size_t i=0;i<5;i++) {
+      f2.mu=mu[i];
+      fr2.calc_mu(f2,Tb[i]);
+      t.test_rel(nd[i],f2.n,1.0e-12,"calc_mu_batch n");
+      t.test_rel(ed[i],f2.ed,1.0e-12,"calc_mu_batch ed");
+      t.test_rel(pr[i],f2.pr,1.0e-12,"calc_mu_batch pr");
+      t.test_rel(en[i],f2.en,1.0e-12,"calc_mu_batch en");
+    }
+    f2.mu=mu[0];
+    int ret=fr2.calc_density_batch(f2,5,nd,Tb,mu2,ed,pr,en);
+    t.test_gen(ret==0,"calc_density_batch ret");
+    for(size_t i=0;i<5;i++) {
+      t.test_rel(mu2[i],mu[i],1.0e-6,"calc_density_batch");
+    }
+  }
+
+  // -----------------------------------------------------------------
+  // Test the tabulated approximation
+
+  {
+    fermion_rel fr2;
+    double dev=fr2.build_table(-4.0,20.0,1.0e-2,1.0e2);
+    t.test_gen(dev<fr2.table_tol,"table deviation");
+    
+    fermion f2(1.0,2.0), f3(1.0,2.0);
+    for(double T=0.02;T<90.0;T*=4.1) {
+      for(double psi=-3.5;psi<19.0;psi+=2.7) {
+	
+	f2.mu=1.0+psi*T;
+	f3.mu=f2.mu;
+	fr2.use_table=false;
+	fr2.calc_mu(f2,T);
+	fr2.use_table=true;
+	fr2.calc_mu(f3,T);
+	t.test_gen(fr2.last_method==10,"table calc_mu method");
+	t.test_rel(f3.n,f2.n,1.0e-6,"table n");
+	t.test_rel(f3.ed,f2.ed,1.0e-6,"table ed");
+	t.test_rel(f3.pr,f2.pr,1.0e-6,"table pr");
+	t.test_rel(f3.en,f2.en,1.0e-6,"table en");
+
+	f3.n=f2.n;
+	f3.mu=f2.mu*1.1;
+	fr2.calc_density(f3,T);
+	t.test_gen(fr2.last_method==50,"table calc_density method");
+	t.test_rel(f3.mu,f2.mu,1.0e-6,"table calc_density");
+      }
+    }
+
+    // Points outside the table use the integrators
+    f3.mu=1.0+25.0*0.1;
+    fr2.calc_mu(f3,0.1);
+    t.test_gen(fr2.last_method!=10,"outside table");
+
+    // Pairs
+    f2.n=0.1;
+    f2.mu=1.5;
+    fr2.use_table=false;
+    fr2.pair_density(f2,0.5);
+    f3.n=0.1;
+    f3.mu=1.5;
+    fr2.use_table=true;
+    fr2.pair_density(f3,0.5);
+    t.test_rel(f3.mu,f2.mu,1.0e-6,"table pair_density");
+
+    // A copy of the settings uses the same table and tolerances
+    fermion_rel fr3;
+    fr2.density_root->tol_rel=1.0e-9;
+    fr3.copy_settings(fr2);
+    t.test_gen(fr3.table_built(),"copy_settings table");
+    t.test_rel(fr3.density_root->tol_rel,1.0e-9,1.0e-15,
+	       "copy_settings tol");
+    f3.mu=1.0+2.0*0.5;
+    f2.mu=f3.mu;
+    fr2.calc_mu(f2,0.5);
+    fr3.calc_mu(f3,0.5);
+    t.test_gen(fr3.last_method==10,"copy_settings method");
+    t.test_rel(f3.n,f2.n,1.0e-15,"copy_settings n");
+  }
+
   // -----------------------------------------------------------------
   // Downcast the shared_ptr to the default integration type. This
   // shows how to get access the internal integration object that
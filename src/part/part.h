@@ -200,6 +200,76 @@ namespace o2scl {
    */
   extern thermo operator-(const thermo &left, const part &right);
 
+  /** \brief Compute the thermodynamics of a copy of \c p for 
+      \c n values of the chemical potential and temperature
+      
+      For each point, the value <tt>mu[i]</tt> is stored in
+      <tt>part::mu</tt> if <tt>part::non_interacting</tt> is true and
+      in <tt>part::nu</tt> otherwise, then \c calc is called with the
+      copy and <tt>T[i]</tt>, and the density, energy density,
+      pressure, and entropy are stored in <tt>nd[i]</tt>,
+      <tt>ed[i]</tt>, <tt>pr[i]</tt> and <tt>en[i]</tt>. The object
+      \c p is not modified.
+
+      This is used by the batched functions in the particle 
+      thermodynamics classes, which give a function object
+      which calls the relevant member function directly.
+  */
+  template<class part_t, class func_t>
+    void part_batch_mu(const part_t &p, size_t n, const double *mu,
+		       const double *T, double *nd, double *ed,
+		       double *pr, double *en, func_t &&calc) {
+    part_t pt=p;
+    for(size_t i=0;i<n;i++) {
+      if (pt.non_interacting) pt.mu=mu[i];
+      else pt.nu=mu[i];
+      calc(pt,T[i]);
+      nd[i]=pt.n;
+      ed[i]=pt.ed;
+      pr[i]=pt.pr;
+      en[i]=pt.en;
+    }
+    return;
+  }
+
+  /** \brief Compute the thermodynamics of a copy of \c p for 
+      \c n values of the density and temperature
+
+      For each point, <tt>nd[i]</tt> is stored in <tt>part::n</tt>,
+      then \c calc is called with the copy and <tt>T[i]</tt>, and
+      the chemical potential (<tt>part::mu</tt> if
+      <tt>part::non_interacting</tt> is true and <tt>part::nu</tt>
+      otherwise), energy density, pressure, and entropy are stored
+      in <tt>mu[i]</tt>, <tt>ed[i]</tt>, <tt>pr[i]</tt> and
+      <tt>en[i]</tt>. The chemical potential in \c p is used as the
+      initial guess for the first point, and the result from each
+      point is used as the initial guess for the next. The object
+      \c p is not modified.
+
+      The function \c calc must return an integer which is zero
+      on success. This function returns zero if all points 
+      succeeded and otherwise returns the first nonzero value 
+      returned by \c calc.
+  */
+  template<class part_t, class func_t>
+    int part_batch_density(const part_t &p, size_t n, const double *nd,
+			   const double *T, double *mu, double *ed,
+			   double *pr, double *en, func_t &&calc) {
+    part_t pt=p;
+    int ret=0;
+    for(size_t i=0;i<n;i++) {
+      pt.n=nd[i];
+      int ret2=calc(pt,T[i]);
+      if (ret==0 && ret2!=0) ret=ret2;
+      if (pt.non_interacting) mu[i]=pt.mu;
+      else mu[i]=pt.nu;
+      ed[i]=pt.ed;
+      pr[i]=pt.pr;
+      en[i]=pt.en;
+    }
+    return ret;
+  }
+
   /** \brief Object to organize calibration of particle classes
       to results stored in a table
    */